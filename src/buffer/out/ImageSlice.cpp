@@ -9,11 +9,117 @@
 
 static std::atomic<uint64_t> s_revision{ 0 };
 
+// Image slices are created and discarded at a high rate when streaming sixel
+// content, since every row that is scrolled off or overwritten drops its slice,
+// and every new row needs one. Rather than returning the pixel buffers to the
+// heap, we keep a few MiB of them around for reuse. The pool is per-thread
+// so that it doesn't require any locking, since the buffers are only ever
+// accessed by the thread that holds the console lock at the time.
+namespace
+{
+    // Slices may still be destroyed after the pool during thread or process
+    // shutdown, so we track its lifetime with a trivially destructible flag.
+    thread_local bool s_pixelBufferPoolAlive = false;
+
+    struct PixelBufferPool
+    {
+        static constexpr size_t Capacity = 32;
+        // The total size of the pooled buffers is capped as well, since a single
+        // pixel row of a large image may already be several hundred KiB large.
+        static constexpr size_t CapacityBytes = 4 * 1024 * 1024;
+
+        PixelBufferPool() noexcept
+        {
+            s_pixelBufferPoolAlive = true;
+        }
+
+        ~PixelBufferPool()
+        {
+            s_pixelBufferPoolAlive = false;
+        }
+
+        std::vector<std::vector<RGBQUAD>> buffers;
+        size_t bytes = 0;
+    };
+
+    thread_local PixelBufferPool s_pixelBufferPool;
+}
+
 ImageSlice::ImageSlice(const til::size cellSize) noexcept :
     _cellSize{ cellSize }
 {
 }
 
+ImageSlice::~ImageSlice()
+{
+    _releasePixels();
+}
+
+// Returns a zero-initialized buffer of the given size, reusing the allocation
+// of a previously discarded buffer if there's a suitable one in the pool. We
+// don't reuse buffers that are much larger than needed, since that memory
+// would otherwise be held for as long as the slice exists.
+ImageSlice::PixelBuffer ImageSlice::_acquirePixelBuffer(const size_t size)
+{
+    auto& pool = s_pixelBufferPool.buffers;
+    for (auto i = pool.size(); i-- > 0;)
+    {
+        const auto capacity = til::at(pool, i).capacity();
+        if (capacity >= size && capacity / 2 <= size)
+        {
+            std::swap(til::at(pool, i), pool.back());
+            auto buffer = std::move(pool.back());
+            pool.pop_back();
+            s_pixelBufferPool.bytes -= capacity * sizeof(RGBQUAD);
+            buffer.resize(size);
+            return buffer;
+        }
+    }
+    return PixelBuffer(size);
+}
+
+void ImageSlice::_recyclePixelBuffer(PixelBuffer&& buffer) noexcept
+try
+{
+    if (!s_pixelBufferPoolAlive || buffer.capacity() == 0)
+    {
+        return;
+    }
+    auto& pool = s_pixelBufferPool;
+    const auto bytes = buffer.capacity() * sizeof(RGBQUAD);
+    if (pool.buffers.size() < PixelBufferPool::Capacity && bytes <= PixelBufferPool::CapacityBytes - pool.bytes)
+    {
+        buffer.clear();
+        pool.buffers.emplace_back(std::move(buffer));
+        pool.bytes += bytes;
+    }
+}
+CATCH_LOG()
+
+// Drops this slice's reference to its pixels. If it was the last reference,
+// the buffer is returned to the pool.
+void ImageSlice::_releasePixels() noexcept
+{
+    if (_pixelBuffer && _pixelBuffer.use_count() == 1)
+    {
+        _recyclePixelBuffer(std::move(*_pixelBuffer));
+    }
+    _pixelBuffer.reset();
+}
+
+// Ensures that this slice is the only owner of its pixels, which must be the
+// case before they can be modified, since the buffer may be shared with the
+// slices of other rows (or other buffers) that this slice was copied from.
+void ImageSlice::_makePixelsUnique()
+{
+    if (_pixelBuffer && _pixelBuffer.use_count() > 1)
+    {
+        auto buffer = _acquirePixelBuffer(_pixelBuffer->size());
+        std::copy(_pixelBuffer->begin(), _pixelBuffer->end(), buffer.begin());
+        _pixelBuffer = std::make_shared<PixelBuffer>(std::move(buffer));
+    }
+}
+
 void ImageSlice::BumpRevision() noexcept
 {
     // Avoid setting the revision to 0. This allows the renderer to use 0 as a sentinel value.
@@ -43,37 +149,46 @@ til::CoordType ImageSlice::PixelWidth() const noexcept
     return _pixelWidth;
 }
 
+bool ImageSlice::SharesPixelsWith(const ImageSlice& other) const noexcept
+{
+    return _pixelBuffer && _pixelBuffer == other._pixelBuffer;
+}
+
 std::span<const RGBQUAD> ImageSlice::Pixels() const noexcept
 {
-    return _pixelBuffer;
+    if (!_pixelBuffer)
+    {
+        return {};
+    }
+    return *_pixelBuffer;
 }
 
 const RGBQUAD* ImageSlice::Pixels(const til::CoordType columnBegin) const noexcept
 {
     const auto pixelOffset = (columnBegin - _columnBegin) * _cellSize.width;
-    return &til::at(_pixelBuffer, pixelOffset);
+    return &til::at(*_pixelBuffer, pixelOffset);
 }
 
 RGBQUAD* ImageSlice::MutablePixels(const til::CoordType columnBegin, const til::CoordType columnEnd)
 {
+    const auto existingData = _pixelBuffer && !_pixelBuffer->empty();
     // IF the buffer is empty or isn't large enough for the requested range, we'll need to resize it.
-    if (_pixelBuffer.empty() || columnBegin < _columnBegin || columnEnd > _columnEnd)
+    if (!existingData || columnBegin < _columnBegin || columnEnd > _columnEnd)
     {
         const auto oldColumnBegin = _columnBegin;
         const auto oldPixelWidth = _pixelWidth;
-        const auto existingData = !_pixelBuffer.empty();
         _columnBegin = existingData ? std::min(_columnBegin, columnBegin) : columnBegin;
         _columnEnd = existingData ? std::max(_columnEnd, columnEnd) : columnEnd;
         _pixelWidth = (_columnEnd - _columnBegin) * _cellSize.width;
         const auto bufferSize = _pixelWidth * _cellSize.height;
+        auto newPixelBuffer = _acquirePixelBuffer(bufferSize);
         if (existingData)
         {
             // If there is existing data in the buffer, we need to copy it
             // across to the appropriate position in the new buffer.
-            auto newPixelBuffer = std::vector<RGBQUAD>(bufferSize);
             const auto newPixelOffset = (oldColumnBegin - _columnBegin) * _cellSize.width;
             auto newIterator = std::next(newPixelBuffer.data(), newPixelOffset);
-            auto oldIterator = _pixelBuffer.data();
+            auto oldIterator = _pixelBuffer->data();
             // Because widths are rounded up to multiples of 4, it's possible
             // that the old width will extend past the right border of the new
             // buffer, so the range that we copy must be clamped to fit.
@@ -84,16 +199,18 @@ RGBQUAD* ImageSlice::MutablePixels(const til::CoordType columnBegin, const til::
                 std::advance(oldIterator, oldPixelWidth);
                 std::advance(newIterator, _pixelWidth);
             }
-            _pixelBuffer = std::move(newPixelBuffer);
-        }
-        else
-        {
-            // Otherwise we just initialize the buffer to the correct size.
-            _pixelBuffer.resize(bufferSize);
         }
+        // Any other slices sharing the old buffer are unaffected by this,
+        // since we always switch over to the newly allocated buffer.
+        _releasePixels();
+        _pixelBuffer = std::make_shared<PixelBuffer>(std::move(newPixelBuffer));
+    }
+    else
+    {
+        _makePixelsUnique();
     }
     const auto pixelOffset = (columnBegin - _columnBegin) * _cellSize.width;
-    return &til::at(_pixelBuffer, pixelOffset);
+    return &til::at(*_pixelBuffer, pixelOffset);
 }
 
 void ImageSlice::CopyBlock(const TextBuffer& srcBuffer, const til::rect srcRect, TextBuffer& dstBuffer, const til::rect dstRect)
@@ -140,13 +257,17 @@ void ImageSlice::CopyCells(const ROW& srcRow, const til::CoordType srcColumn, RO
     }
     else
     {
+        const auto scale = srcRow.GetLineRendition() != LineRendition::SingleWidth ? 1 : 0;
+        if (_tryShareCells(*srcSlice, srcColumn << scale, dstRow, dstColumnBegin << scale, dstColumnEnd << scale))
+        {
+            return;
+        }
         auto dstSlice = dstRow.GetMutableImageSlice();
         if (!dstSlice)
         {
             dstSlice = dstRow.SetImageSlice(std::make_unique<ImageSlice>(srcSlice->CellSize()));
             __assume(dstSlice != nullptr);
         }
-        const auto scale = srcRow.GetLineRendition() != LineRendition::SingleWidth ? 1 : 0;
         if (dstSlice->_copyCells(*srcSlice, srcColumn << scale, dstColumnBegin << scale, dstColumnEnd << scale))
         {
             // If _copyCells returns true, that means the destination was
@@ -156,6 +277,33 @@ void ImageSlice::CopyCells(const ROW& srcRow, const til::CoordType srcColumn, RO
     }
 }
 
+// If the copy range covers all of the source content, and will overwrite all of
+// the existing destination content, then the destination row can just share
+// the source pixels, with the column range offset to the new position. This
+// turns the common cases of copying or moving entire image rows (scrolling,
+// DECCRA, buffer switches, reflow) into a pointer copy.
+bool ImageSlice::_tryShareCells(const ImageSlice& srcSlice, const til::CoordType srcColumn, ROW& dstRow, const til::CoordType dstColumnBegin, const til::CoordType dstColumnEnd)
+{
+    const auto srcColumnEnd = srcColumn + dstColumnEnd - dstColumnBegin;
+    if (!srcSlice._pixelBuffer || srcSlice._columnBegin < srcColumn || srcSlice._columnEnd > srcColumnEnd)
+    {
+        return false;
+    }
+
+    const auto dstSlice = dstRow.GetImageSlice();
+    if (dstSlice && dstSlice->_pixelBuffer && (dstSlice->_columnBegin < dstColumnBegin || dstSlice->_columnEnd > dstColumnEnd))
+    {
+        return false;
+    }
+
+    const auto projectedOffset = dstColumnBegin - srcColumn;
+    auto sharedSlice = std::make_unique<ImageSlice>(srcSlice);
+    sharedSlice->_columnBegin += projectedOffset;
+    sharedSlice->_columnEnd += projectedOffset;
+    dstRow.SetImageSlice(std::move(sharedSlice));
+    return true;
+}
+
 bool ImageSlice::_copyCells(const ImageSlice& srcSlice, const til::CoordType srcColumn, const til::CoordType dstColumnBegin, const til::CoordType dstColumnEnd)
 {
     const auto srcColumnEnd = srcColumn + dstColumnEnd - dstColumnBegin;
@@ -246,9 +394,10 @@ bool ImageSlice::_eraseCells(const til::CoordType columnBegin, const til::CoordT
         const auto eraseEnd = std::min(columnEnd, _columnEnd);
         if (eraseBegin < eraseEnd)
         {
+            _makePixelsUnique();
             const auto eraseOffset = (eraseBegin - _columnBegin) * _cellSize.width;
             const auto eraseLength = (eraseEnd - eraseBegin) * _cellSize.width;
-            auto eraseIterator = std::next(_pixelBuffer.data(), eraseOffset);
+            auto eraseIterator = std::next(_pixelBuffer->data(), eraseOffset);
             for (auto y = 0; y < _cellSize.height; y++)
             {
                 std::memset(eraseIterator, 0, eraseLength * sizeof(RGBQUAD));
@@ -7,6 +7,10 @@ Module Name:
 
 Abstract:
 - This serves as a structure to represent a slice of an image covering one textbuffer row.
+- The pixel data is held in a reference-counted buffer, which may be shared by
+  multiple slices, so copying a slice (or moving it to another column) doesn't
+  require the pixels to be copied. The buffer is only duplicated when a slice
+  that shares it needs to be modified (copy-on-write).
 --*/
 
 #pragma once
@@ -25,6 +29,7 @@ public:
 
     ImageSlice(const ImageSlice& rhs) = default;
     ImageSlice(const til::size cellSize) noexcept;
+    ~ImageSlice();
 
     void BumpRevision() noexcept;
     uint64_t Revision() const noexcept;
@@ -32,6 +37,7 @@ public:
     til::size CellSize() const noexcept;
     til::CoordType ColumnOffset() const noexcept;
     til::CoordType PixelWidth() const noexcept;
+    bool SharesPixelsWith(const ImageSlice& other) const noexcept;
 
     std::span<const RGBQUAD> Pixels() const noexcept;
     const RGBQUAD* Pixels(const til::CoordType columnBegin) const noexcept;
@@ -45,12 +51,20 @@ public:
     static void EraseCells(ROW& row, const til::CoordType columnBegin, const til::CoordType columnEnd);
 
 private:
+    using PixelBuffer = std::vector<RGBQUAD>;
+
+    static PixelBuffer _acquirePixelBuffer(const size_t size);
+    static void _recyclePixelBuffer(PixelBuffer&& buffer) noexcept;
+    static bool _tryShareCells(const ImageSlice& srcSlice, const til::CoordType srcColumn, ROW& dstRow, const til::CoordType dstColumnBegin, const til::CoordType dstColumnEnd);
+
+    void _releasePixels() noexcept;
+    void _makePixelsUnique();
     bool _copyCells(const ImageSlice& srcSlice, const til::CoordType srcColumn, const til::CoordType dstColumnBegin, const til::CoordType dstColumnEnd);
     bool _eraseCells(const til::CoordType columnBegin, const til::CoordType columnEnd);
 
     uint64_t _revision = 0;
     til::size _cellSize;
-    std::vector<RGBQUAD> _pixelBuffer;
+    std::shared_ptr<PixelBuffer> _pixelBuffer;
     til::CoordType _columnBegin = 0;
     til::CoordType _columnEnd = 0;
     til::CoordType _pixelWidth = 0;
@@ -80,6 +80,50 @@ constexpr OutIt copy_n_small(InIt first, Diff count, OutIt dest)
     return dest;
 }
 
+// Returns a pointer past the last non-whitespace character in [beg, end), or beg if it's all whitespace.
+// Rows usually end in long runs of whitespace, which this skips 8 characters at a time.
+static const wchar_t* skipTrailingWhitespace(const wchar_t* beg, const wchar_t* end) noexcept
+{
+#pragma warning(push)
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+#pragma warning(disable : 26490) // Don't use reinterpret_cast (type.1).
+#if defined(TIL_SSE_INTRINSICS)
+    const auto whitespace = _mm_set1_epi16(L' ');
+    while (end - beg >= 8)
+    {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(end - 8));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(chunk, whitespace)) != 0xffff)
+        {
+            break;
+        }
+        end -= 8;
+    }
+#elif defined(TIL_ARM_NEON_INTRINSICS)
+    const auto whitespace = vdupq_n_u16(L' ');
+    while (end - beg >= 8)
+    {
+        const auto chunk = vld1q_u16(reinterpret_cast<const uint16_t*>(end - 8));
+        const auto equal = vmovn_u16(vceqq_u16(chunk, whitespace));
+        if (vget_lane_u64(vreinterpret_u64_u8(equal), 0) != UINT64_MAX)
+        {
+            break;
+        }
+        end -= 8;
+    }
+#endif
+
+    // The remaining (up to 8) characters contain the last non-whitespace one, if any.
+    for (; end != beg; --end)
+    {
+        if (end[-1] != L' ')
+        {
+            break;
+        }
+    }
+    return end;
+#pragma warning(pop)
+}
+
 CharToColumnMapper::CharToColumnMapper(const wchar_t* chars, const uint16_t* charOffsets, ptrdiff_t lastCharOffset, til::CoordType currentColumn) noexcept :
     _chars{ chars },
     _charOffsets{ charOffsets },
@@ -230,7 +274,26 @@ void ROW::Reset(const TextAttribute& attr) noexcept
     _wrapForced = false;
     _doubleBytePadded = false;
     _promptData = std::nullopt;
-    _init();
+    _initDirty();
+    _textExtent = 0;
+}
+
+// Same as _init(), but only restores the _dirtyEnd leading columns.
+void ROW::_initDirty() noexcept
+{
+    if (_dirtyEnd >= _columnCount)
+    {
+        _init();
+        return;
+    }
+    if (_dirtyEnd)
+    {
+        std::fill_n(_charsBuffer, _dirtyEnd, L' ');
+        // +1, because the past-the-end offset at _charOffsets[_dirtyEnd] may have been modified
+        // as well. For instance, if a wide glyph was written into the last dirty column.
+        iota_n(_charOffsets.begin(), _dirtyEnd + 1, uint16_t{ 0 });
+        _dirtyEnd = 0;
+    }
 }
 
 void ROW::_init() noexcept
@@ -345,6 +408,9 @@ void ROW::_init() noexcept
     std::iota(_charOffsets.begin(), _charOffsets.end(), uint16_t{ 0 });
 #endif
 
+    _dirtyEnd = 0;
+    _textExtent = 0;
+
 #pragma warning(push)
 }
 
@@ -581,6 +647,8 @@ catch (...)
     // Due to this function writing _charOffsets first, then calling _resizeChars (which may throw) and only then finally
     // filling in _chars, we might end up in a situation were _charOffsets contains offsets outside of the _chars array.
     // --> Restore this row to a known "okay"-state.
+    // The write may have modified _charOffsets beyond _dirtyEnd, so we need to restore all of it.
+    _dirtyEnd = _columnCount;
     Reset(TextAttribute{});
     throw;
 }
@@ -632,6 +700,7 @@ try
 }
 catch (...)
 {
+    _dirtyEnd = _columnCount;
     Reset(TextAttribute{});
     throw;
 }
@@ -806,6 +875,7 @@ try
 }
 catch (...)
 {
+    _dirtyEnd = _columnCount;
     Reset(TextAttribute{});
     throw;
 }
@@ -867,6 +937,11 @@ catch (...)
     {
         row._resizeChars(colEndDirty, chBegDirty, chEndDirty, chEndDirtyOld);
     }
+    else
+    {
+        const auto dirtyEnd = std::max<size_t>(colEndDirty, chEndDirty);
+        row._dirtyEnd = gsl::narrow_cast<uint16_t>(std::min<size_t>(std::max<size_t>(row._dirtyEnd, dirtyEnd), row._columnCount));
+    }
 
     {
         // std::copy_n compiles to memmove. We can do better. It also gets rid of an extra branch,
@@ -898,6 +973,21 @@ catch (...)
     {
         row.SetDoubleBytePadded(colEnd < row._columnCount);
     }
+
+    // Only [colBegDirty, colEndDirty) changed, so if the row's text ended inside or before it, measuring those
+    // columns is enough to update _textExtent. If we erased the row's last text, we don't know where it ends anymore.
+    if (const auto extent = row._textExtent; extent != TextExtentUnknown && extent <= colEndDirty)
+    {
+        const auto written = row._measureTextExtent(colBegDirty, colEndDirty);
+        if (written > colBegDirty)
+        {
+            row._textExtent = written;
+        }
+        else if (extent > colBegDirty)
+        {
+            row._textExtent = TextExtentUnknown;
+        }
+    }
 }
 
 // This function represents the slow path of ReplaceCharacters(),
@@ -935,6 +1025,9 @@ void ROW::_resizeChars(uint16_t colEndDirty, uint16_t chBegDirty, size_t chEndDi
     {
         *it = gsl::narrow_cast<uint16_t>(*it + diff);
     }
+
+    // All of the following offsets were shifted, as well as the contents of _chars.
+    _dirtyEnd = _columnCount;
 }
 
 til::small_rle<TextAttribute, uint16_t, 1>& ROW::Attributes() noexcept
@@ -952,19 +1045,6 @@ TextAttribute ROW::GetAttrByColumn(const til::CoordType column) const
     return _attr.at(_clampedColumn(column));
 }
 
-std::vector<uint16_t> ROW::GetHyperlinks() const
-{
-    std::vector<uint16_t> ids;
-    for (const auto& run : _attr.runs())
-    {
-        if (run.value.IsHyperlink())
-        {
-            ids.emplace_back(run.value.GetHyperlinkId());
-        }
-    }
-    return ids;
-}
-
 ImageSlice* ROW::SetImageSlice(ImageSlice::Pointer imageSlice) noexcept
 {
     _imageSlice = std::move(imageSlice);
@@ -996,27 +1076,37 @@ uint16_t ROW::size() const noexcept
 // - Retrieves the column that is one after the last non-space character in the row.
 til::CoordType ROW::GetLastNonSpaceColumn() const noexcept
 {
-    const auto text = GetText();
-    const auto beg = text.data();
-    const auto end = beg + text.size();
-#pragma warning(suppress : 26429) // Symbol 'it' is never tested for nullness, it can be marked as not_null (f.23).
-    auto it = end;
+    if (_textExtent == TextExtentUnknown)
+    {
+        _textExtent = _measureTextExtent(0, _columnCount);
+    }
 
-    for (; it != beg; --it)
+    // All columns past _textExtent are whitespace. As long as it lies within the readable columns, that's our answer.
+    // Otherwise the readable part ends in the middle of the text (e.g. in a DECDWL row) and we have to measure it.
+    const auto columns = GetReadableColumnCount();
+    if (_textExtent <= columns) [[likely]]
     {
-        // it[-1] is safe as `it` is always greater than `beg` (loop invariant).
-        if (it[-1] != L' ')
-        {
-            break;
-        }
+        return _textExtent;
     }
+    return _measureTextExtent(0, gsl::narrow_cast<uint16_t>(columns));
+}
+
+// Returns the column 1 past the last non-whitespace glyph in [colBeg, colEnd), or colBeg if there's none.
+uint16_t ROW::_measureTextExtent(uint16_t colBeg, uint16_t colEnd) const noexcept
+{
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+    const auto beg = _chars.data() + _uncheckedCharOffset(colBeg);
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+    const auto end = _chars.data() + _uncheckedCharOffset(colEnd);
+    const auto it = skipTrailingWhitespace(beg, end);
 
     // We're supposed to return the measurement in cells and not characters
     // and therefore simply calculating `it - beg` would be wrong.
     //
     // An example: The row is 10 cells wide and `it` points to the second character.
     // `it - beg` would return 1, but it's possible it's actually 1 wide glyph and 8 whitespace.
-    return gsl::narrow_cast<til::CoordType>(GetReadableColumnCount() - (end - it));
+    // Each trailing whitespace on the other hand is exactly 1 cell wide.
+    return gsl::narrow_cast<uint16_t>(colEnd - (end - it));
 }
 
 til::CoordType ROW::MeasureLeft() const noexcept
@@ -1056,20 +1146,7 @@ til::CoordType ROW::MeasureRight() const noexcept
 
 bool ROW::ContainsText() const noexcept
 {
-    const auto text = GetText();
-    const auto beg = text.begin();
-    const auto end = text.end();
-    auto it = beg;
-
-    for (; it != end; ++it)
-    {
-        if (*it != L' ')
-        {
-            return true;
-        }
-    }
-
-    return false;
+    return GetLastNonSpaceColumn() != 0;
 }
 
 std::wstring_view ROW::GlyphAt(til::CoordType column) const noexcept
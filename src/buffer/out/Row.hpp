@@ -144,6 +144,13 @@ public:
     OutputCellIterator WriteCells(OutputCellIterator it, til::CoordType columnBegin, std::optional<bool> wrap = std::nullopt, std::optional<til::CoordType> limitRight = std::nullopt);
     void SetAttrToEnd(til::CoordType columnBegin, TextAttribute attr);
     void ReplaceAttributes(til::CoordType beginIndex, til::CoordType endIndex, const TextAttribute& newAttr);
+    // Replaces every attribute in [beginIndex, endIndex) with func(attribute). func is called once per run, not per column.
+    template<typename Func>
+    void TransformAttributes(til::CoordType beginIndex, til::CoordType endIndex, Func&& func)
+    {
+        const auto clamp = [this](til::CoordType v) noexcept { return gsl::narrow_cast<uint16_t>(std::clamp<til::CoordType>(v, 0, _columnCount)); };
+        _attr.transform(clamp(beginIndex), clamp(endIndex), std::forward<Func>(func));
+    }
     void ReplaceCharacters(til::CoordType columnBegin, til::CoordType width, const std::wstring_view& chars);
     void ReplaceText(RowWriteState& state);
     void CopyTextFrom(RowCopyTextFromState& state);
@@ -151,7 +158,6 @@ public:
     til::small_rle<TextAttribute, uint16_t, 1>& Attributes() noexcept;
     const til::small_rle<TextAttribute, uint16_t, 1>& Attributes() const noexcept;
     TextAttribute GetAttrByColumn(til::CoordType column) const;
-    std::vector<uint16_t> GetHyperlinks() const;
     ImageSlice* SetImageSlice(ImageSlice::Pointer imageSlice) noexcept;
     const ImageSlice* GetImageSlice() const noexcept;
     ImageSlice* GetMutableImageSlice() noexcept;
@@ -176,6 +182,7 @@ public:
     void StartPrompt() noexcept;
     void EndOutput(std::optional<unsigned int> error) noexcept;
 
+    friend class RowView;
 #ifdef UNIT_TESTING
     friend constexpr bool operator==(const ROW& a, const ROW& b) noexcept;
     friend class RowTests;
@@ -233,6 +240,8 @@ private:
     // trailing half of a wide glyph. This simplifies many implementation details via _uncheckedIsTrailer.
     static constexpr uint16_t CharOffsetsTrailer = 0x8000;
     static constexpr uint16_t CharOffsetsMask = 0x7fff;
+    // Marks _textExtent as outdated.
+    static constexpr uint16_t TextExtentUnknown = UINT16_MAX;
 
     template<typename T>
     constexpr uint16_t _clampedColumn(T v) const noexcept;
@@ -253,6 +262,8 @@ private:
 
     void _init() noexcept;
     void _resizeChars(uint16_t colEndDirty, uint16_t chBegDirty, size_t chEndDirty, uint16_t chEndDirtyOld);
+    void _initDirty() noexcept;
+    uint16_t _measureTextExtent(uint16_t colBeg, uint16_t colEnd) const noexcept;
     CharToColumnMapper _createCharToColumnMapper(ptrdiff_t offset) const noexcept;
 
     // These fields are a bit "wasteful", but it makes all this a bit more robust against
@@ -300,6 +311,15 @@ private:
     til::small_rle<TextAttribute, uint16_t, 1> _attr;
     // The width of the row in visual columns.
     uint16_t _columnCount = 0;
+    // The number of leading columns (and chars) that may have been written to since the last _init().
+    // Beyond it, _charsBuffer is guaranteed to only contain whitespace and _charOffsets successive numbers.
+    // This allows Reset() to only restore the part of the row that was actually used, which turns line feeds
+    // into a (mostly) constant time operation when printing short lines, like the output of `yes` or logs.
+    uint16_t _dirtyEnd = 0;
+    // The column 1 past the last non-whitespace glyph across all _columnCount columns, or TextExtentUnknown.
+    // Reset() and WriteHelper::Finish() keep it up to date, so that GetLastNonSpaceColumn() and MeasureRight()
+    // don't need to scan the row over and over again when they're called for every row of the buffer.
+    mutable uint16_t _textExtent = 0;
     // Stores double-width/height (DECSWL/DECDWL/DECDHL) attributes.
     LineRendition _lineRendition = LineRendition::SingleWidth;
     // Occurs when the user runs out of text in a given row and we're forced to wrap the cursor to the next line
@@ -313,6 +333,72 @@ private:
     ImageSlice::Pointer _imageSlice;
 };
 
+// A lightweight, read-only view over the text and attributes of a ROW.
+// It gives consumers like the renderer direct access to the underlying _chars, _charOffsets and
+// attribute runs, so that they can walk a row glyph by glyph and run by run without
+// materializing an OutputCellView per column like TextBufferCellIterator does.
+// The view must not outlive the ROW and is invalidated by any modification of it.
+class RowView
+{
+public:
+    struct Glyph
+    {
+        std::wstring_view text;
+        // The glyph covers the columns [columnBegin,columnEnd). If GlyphAt() was called with the
+        // column of the trailing half of a wide glyph, columnBegin will be less than that column.
+        til::CoordType columnBegin = 0;
+        til::CoordType columnEnd = 0;
+    };
+
+    explicit RowView(const ROW& row) noexcept :
+        _chars{ row._chars.data() },
+        _charOffsets{ row._charOffsets },
+        _attr{ row._attr },
+        _columnCount{ row._columnCount }
+    {
+    }
+
+    til::CoordType size() const noexcept
+    {
+        return _columnCount;
+    }
+
+    const til::small_rle<TextAttribute, uint16_t, 1>& Attributes() const noexcept
+    {
+        return _attr;
+    }
+
+    // Returns the glyph covering the given column, which must be in the range [0, size()).
+    Glyph GlyphAt(til::CoordType column) const noexcept
+    {
+        assert(column >= 0 && column < _columnCount);
+
+        auto beg = column;
+        while (beg > 0 && (til::at(_charOffsets, beg) & ROW::CharOffsetsTrailer))
+        {
+            beg--;
+        }
+
+        // Safety: the last _charOffset at index _columnCount never has the CharOffsetsTrailer flag.
+        auto end = column + 1;
+        while (til::at(_charOffsets, end) & ROW::CharOffsetsTrailer)
+        {
+            end++;
+        }
+
+        const size_t chBeg = til::at(_charOffsets, beg) & ROW::CharOffsetsMask;
+        const size_t chEnd = til::at(_charOffsets, end) & ROW::CharOffsetsMask;
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+        return { { _chars + chBeg, chEnd - chBeg }, beg, end };
+    }
+
+private:
+    const wchar_t* _chars;
+    std::span<const uint16_t> _charOffsets;
+    const til::small_rle<TextAttribute, uint16_t, 1>& _attr;
+    til::CoordType _columnCount;
+};
+
 #ifdef UNIT_TESTING
 constexpr bool operator==(const ROW& a, const ROW& b) noexcept
 {
@@ -69,7 +69,7 @@ TextBuffer::~TextBuffer()
 {
     if (_buffer)
     {
-        _destroy();
+        _recycle();
     }
 }
 
@@ -81,6 +81,64 @@ TextBuffer::~TextBuffer()
 #pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
 #pragma warning(disable : 26490) // Don't use reinterpret_cast (type.1).
 
+// Applications like less, fzf or vim enter and leave the alternate screen buffer all the time, each time
+// constructing a TextBuffer of the exact same size as the one that was just destroyed. Instead of releasing
+// the memory arena of a destroyed TextBuffer via VirtualFree, we hold onto a few of them, so that the next
+// _reserve() of the same size can skip the VirtualAlloc() calls and the page faults on freshly committed memory.
+// The ROWs in a recycled arena are destroyed before it's pooled and lazily reconstructed by _commit() as usual.
+namespace
+{
+    struct RecycledArena
+    {
+        til::virtual_memory buffer;
+        // The number of bytes (starting at buffer) that are still committed.
+        size_t committed = 0;
+    };
+
+    // That's enough for an alternate screen buffer, the DEC pages and a resize or two.
+    constexpr size_t recycledArenaCount = 4;
+    // Arenas with more memory committed than this (= large scrollbacks) are decommitted
+    // before they're pooled, so that we don't hold onto megabytes of unused memory.
+    constexpr size_t recycledArenaMaxCommit = 1024 * 1024;
+
+    wil::srwlock s_recycledArenasLock;
+    std::array<RecycledArena, recycledArenaCount> s_recycledArenas;
+    size_t s_recycledArenasNext = 0;
+
+    RecycledArena takeRecycledArena(const size_t size) noexcept
+    {
+        const auto lock = s_recycledArenasLock.lock_exclusive();
+        for (auto& arena : s_recycledArenas)
+        {
+            if (arena.buffer && arena.buffer.size() == size)
+            {
+                return std::exchange(arena, {});
+            }
+        }
+        return {};
+    }
+
+    void recycleArena(RecycledArena&& recycled) noexcept
+    {
+        if (recycled.committed > recycledArenaMaxCommit)
+        {
+            recycled.buffer.decommit(0, recycled.committed);
+            recycled.committed = 0;
+        }
+
+        // Swap the previous occupant of the slot into `recycled`,
+        // so that it gets freed outside of the lock.
+        const auto lock = s_recycledArenasLock.lock_exclusive();
+        auto slot = std::find_if(s_recycledArenas.begin(), s_recycledArenas.end(), [](const auto& arena) { return !arena.buffer; });
+        if (slot == s_recycledArenas.end())
+        {
+            slot = s_recycledArenas.begin() + s_recycledArenasNext;
+            s_recycledArenasNext = (s_recycledArenasNext + 1) % recycledArenaCount;
+        }
+        std::swap(*slot, recycled);
+    }
+}
+
 // MEM_RESERVEs memory sufficient to store height-many ROW structs,
 // as well as their ROW::_chars and ROW::_charOffsets buffers.
 //
@@ -105,13 +163,18 @@ void TextBuffer::_reserve(til::size screenBufferSize, const TextAttribute& defau
     const auto rowCount = ::base::strict_cast<uint64_t>(h) + 1;
     const auto allocSize = gsl::narrow<size_t>(rowCount * rowStride);
 
+    auto recycled = takeRecycledArena(allocSize);
+    if (!recycled.buffer)
+    {
+        recycled.buffer = til::virtual_memory::reserve(allocSize);
+    }
+
     // NOTE: Modifications to this block of code might have to be mirrored over to ResizeTraditional().
     // It constructs a temporary TextBuffer and then extracts the members below, overwriting itself.
-    _buffer = wil::unique_virtualalloc_ptr<std::byte>{
-        static_cast<std::byte*>(THROW_LAST_ERROR_IF_NULL(VirtualAlloc(nullptr, allocSize, MEM_RESERVE, PAGE_READWRITE)))
-    };
-    _bufferEnd = _buffer.get() + allocSize;
-    _commitWatermark = _buffer.get();
+    _buffer = std::move(recycled.buffer);
+    _bufferEnd = _buffer.data() + allocSize;
+    _bufferCommitted = recycled.committed;
+    _commitWatermark = _buffer.data();
     _initialAttributes = defaultAttributes;
     _bufferRowStride = rowStride;
     _bufferOffsetChars = rowSize;
@@ -133,12 +196,22 @@ __declspec(noinline) void TextBuffer::_commit(const std::byte* row)
     const auto rowEnd = row + _bufferRowStride;
     const auto remaining = gsl::narrow_cast<uintptr_t>(_bufferEnd - _commitWatermark);
     const auto minimum = gsl::narrow_cast<uintptr_t>(rowEnd - _commitWatermark);
-    const auto ideal = minimum + _bufferRowStride * _commitReadAheadRowCount;
+    const auto now = std::chrono::steady_clock::now();
+    _commitReadAheadRows = now - _lastCommit < _commitReadAheadInterval ? std::min(_commitReadAheadRows * 2, _commitReadAheadRowCountMax) : _commitReadAheadRowCount;
+    _lastCommit = now;
+
+    const auto ideal = minimum + _bufferRowStride * _commitReadAheadRows;
     const auto size = std::min(remaining, ideal);
+    const auto end = _commitWatermark + size;
 
-    THROW_LAST_ERROR_IF_NULL(VirtualAlloc(_commitWatermark, size, MEM_COMMIT, PAGE_READWRITE));
+    // A recycled arena (see _reserve()) may already have this memory committed.
+    if (end > _buffer.data() + _bufferCommitted)
+    {
+        _buffer.commit(gsl::narrow_cast<size_t>(_commitWatermark - _buffer.data()), size);
+        _bufferCommitted = gsl::narrow_cast<size_t>(end - _buffer.data());
+    }
 
-    _construct(_commitWatermark + size);
+    _construct(end);
 }
 
 // Destructs and MEM_DECOMMITs all previously constructed ROWs.
@@ -146,8 +219,26 @@ __declspec(noinline) void TextBuffer::_commit(const std::byte* row)
 void TextBuffer::_decommit() noexcept
 {
     _destroy();
-    VirtualFree(_buffer.get(), 0, MEM_DECOMMIT);
-    _commitWatermark = _buffer.get();
+    _buffer.decommit(0, _bufferCommitted);
+    _bufferCommitted = 0;
+    _commitWatermark = _buffer.data();
+}
+
+// Destructs all previously constructed ROWs and hands the memory arena over
+// to the pool of recycled arenas (see _reserve()). Leaves _buffer empty.
+void TextBuffer::_recycle() noexcept
+{
+    _destroy();
+
+    RecycledArena recycled{
+        .buffer = std::move(_buffer),
+        .committed = _bufferCommitted,
+    };
+    _bufferEnd = nullptr;
+    _bufferCommitted = 0;
+    _commitWatermark = nullptr;
+
+    recycleArena(std::move(recycled));
 }
 
 // Constructs ROWs between [_commitWatermark,until).
@@ -165,7 +256,7 @@ void TextBuffer::_construct(const std::byte* until) noexcept
 // Destructs ROWs between [_buffer,_commitWatermark).
 void TextBuffer::_destroy() const noexcept
 {
-    for (auto it = _buffer.get(); it < _commitWatermark; it += _bufferRowStride)
+    for (auto it = _buffer.data(); it < _commitWatermark; it += _bufferRowStride)
     {
         std::destroy_at(reinterpret_cast<ROW*>(it));
     }
@@ -175,8 +266,8 @@ void TextBuffer::_destroy() const noexcept
 // wrap the "offset" parameter modulo the _height of the buffer.
 ROW& TextBuffer::_getRowByOffsetDirect(size_t offset)
 {
-    const auto row = _buffer.get() + _bufferRowStride * offset;
-    THROW_HR_IF(E_UNEXPECTED, row < _buffer.get() || row >= _bufferEnd);
+    const auto row = _buffer.data() + _bufferRowStride * offset;
+    THROW_HR_IF(E_UNEXPECTED, row < _buffer.data() || row >= _bufferEnd);
 
     if (row >= _commitWatermark)
     {
@@ -210,7 +301,7 @@ ROW& TextBuffer::_getRow(til::CoordType y) const
 // Returns 0 if no rows are committed in.
 til::CoordType TextBuffer::_estimateOffsetOfLastCommittedRow() const noexcept
 {
-    const auto lastRowOffset = (_commitWatermark - _buffer.get()) / _bufferRowStride;
+    const auto lastRowOffset = (_commitWatermark - _buffer.data()) / _bufferRowStride;
     // This subtracts 2 from the offset to account for the:
     // * scratchpad row at offset 0, whereas regular rows start at offset 1.
     // * fact that _commitWatermark points _past_ the last committed row,
@@ -861,6 +952,52 @@ void TextBuffer::ScrollRows(const til::CoordType firstRow, til::CoordType size,
     }
 }
 
+// Same as ScrollRows(), but instead of copying the contents of each row it swaps the
+// source and destination ROW objects. ROWs only point into the buffer memory, so this
+// moves a handful of pointers per row and no text, attributes or images.
+// The catch is that the rows scrolled out of the destination range aren't discarded,
+// but end up in the rows that were vacated by the scroll (like std::rotate). Those rows
+// are reset with the given attributes, which also clears their marks and wrap flags.
+void TextBuffer::RotateRows(const til::CoordType firstRow, til::CoordType size, const til::CoordType delta, const TextAttribute& fillAttributes)
+{
+    if (delta == 0)
+    {
+        return;
+    }
+
+    size = std::max(0, size);
+    _rotateRows(firstRow, size, delta);
+
+    // The vacated rows are the part of the source range that isn't also part of the destination range.
+    const auto vacatedBeg = delta < 0 ? std::max(firstRow, firstRow + size + delta) : firstRow;
+    const auto vacatedEnd = delta < 0 ? firstRow + size : std::min(firstRow + size, firstRow + delta);
+    for (auto y = vacatedBeg; y < vacatedEnd; ++y)
+    {
+        GetMutableRowByOffset(y).Reset(fillAttributes);
+    }
+}
+
+// The ROW swapping part of RotateRows(), which leaves the vacated rows as they are.
+void TextBuffer::_rotateRows(const til::CoordType firstRow, const til::CoordType size, const til::CoordType delta)
+{
+    // See ScrollRows() for an explanation of the iteration order.
+    // Swapping rows in this order is equivalent to copying them, except for the vacated rows.
+    auto y = delta < 0 ? firstRow : firstRow + size - 1;
+    const auto end = delta < 0 ? firstRow + size : firstRow - 1;
+    const auto step = delta < 0 ? 1 : -1;
+
+    for (; y != end; y += step)
+    {
+        auto& srcRow = GetMutableRowByOffset(y);
+        auto& dstRow = GetMutableRowByOffset(y + delta);
+        // The offsets are modulo the buffer height, so the two may refer to the same row.
+        if (&srcRow != &dstRow)
+        {
+            std::swap(srcRow, dstRow);
+        }
+    }
+}
+
 void TextBuffer::CopyRow(const til::CoordType srcRowIndex, const til::CoordType dstRowIndex, TextBuffer& dstBuffer) const
 {
     auto& dstRow = dstBuffer.GetMutableRowByOffset(dstRowIndex);
@@ -894,6 +1031,13 @@ void TextBuffer::SetCurrentAttributes(const TextAttribute& currentAttributes) no
     _currentAttributes = currentAttributes;
 }
 
+// Tells the buffer about the attributes that were saved by DECSC, so that their
+// hyperlink isn't pruned while it may still be restored by DECRC.
+void TextBuffer::SetSavedAttributes(const TextAttribute& savedAttributes) noexcept
+{
+    _savedAttributes = savedAttributes;
+}
+
 void TextBuffer::SetWrapForced(const til::CoordType y, bool wrap)
 {
     GetMutableRowByOffset(y).SetWrapForced(wrap);
@@ -999,12 +1143,13 @@ void TextBuffer::ClearScrollback(const til::CoordType newFirstRow, const til::Co
     // Our goal is to move the viewport to the absolute start of the underlying memory buffer so that we can
     // MEM_DECOMMIT the remaining memory. _firstRow is used to make the TextBuffer behave like a circular buffer.
     // The newFirstRow parameter is relative to the _firstRow. The trick to get the content to the absolute start
-    // is to simply add _firstRow ourselves and then reset it to 0. This causes ScrollRows() to write into
+    // is to simply add _firstRow ourselves and then reset it to 0. This causes RotateRows() to write into
     // the absolute start while reading from relative coordinates. This works because GetRowByOffset()
     // operates modulo the buffer height and so the possibly-too-large startAbsolute won't be an issue.
     const auto startAbsolute = _firstRow + newFirstRow;
     _firstRow = 0;
-    ScrollRows(startAbsolute, rowsToKeep, -startAbsolute);
+    // The rows that get rotated out of the way are reset below.
+    _rotateRows(startAbsolute, rowsToKeep, -startAbsolute);
 
     const auto end = _estimateOffsetOfLastCommittedRow();
     for (auto y = rowsToKeep; y <= end; ++y)
@@ -1041,9 +1186,12 @@ void TextBuffer::ResizeTraditional(til::size newSize)
         CopyRow(srcRow, dstRow, newBuffer);
     }
 
+    _recycle();
+
     // NOTE: Keep this in sync with _reserve().
     _buffer = std::move(newBuffer._buffer);
     _bufferEnd = newBuffer._bufferEnd;
+    _bufferCommitted = newBuffer._bufferCommitted;
     _commitWatermark = newBuffer._commitWatermark;
     _initialAttributes = newBuffer._initialAttributes;
     _bufferRowStride = newBuffer._bufferRowStride;
@@ -1411,48 +1559,72 @@ til::point TextBuffer::_GetWordEndForSelection(const til::point target, const st
 
 void TextBuffer::_PruneHyperlinks()
 {
-    // Check the old first row for hyperlink references
-    // If there are any, search the entire buffer for the same reference
-    // If the buffer does not contain the same reference, we can remove that hyperlink from our map
-    // This way, obsolete hyperlink references are cleared from our hyperlink map instead of hanging around
-    // Get all the hyperlink references in the row we're erasing
-    const auto hyperlinks = GetRowByOffset(0).GetHyperlinks();
-
-    if (!hyperlinks.empty())
-    {
-        // Move to unordered set so we can use hashed lookup of IDs instead of linear search.
-        // Only make it an unordered set now because set always heap allocates but vector
-        // doesn't when the set is empty (saving an allocation in the common case of no links.)
-        std::unordered_set<uint16_t> firstRowRefs{ hyperlinks.cbegin(), hyperlinks.cend() };
-
-        const auto total = TotalRowCount();
-        // Loop through all the rows in the buffer except the first row -
-        // we have found all hyperlink references in the first row and put them in refs,
-        // now we need to search the rest of the buffer (i.e. all the rows except the first)
-        // to see if those references are anywhere else
-        for (til::CoordType i = 1; i < total; ++i)
-        {
-            const auto nextRowRefs = GetRowByOffset(i).GetHyperlinks();
-            for (auto id : nextRowRefs)
-            {
-                if (firstRowRefs.find(id) != firstRowRefs.end())
-                {
-                    firstRowRefs.erase(id);
-                }
-            }
-            if (firstRowRefs.empty())
+    // Check the old first row for hyperlink references. Finding out whether they're obsolete requires
+    // a walk over the entire buffer, which is way too expensive to do for every recycled row when tools
+    // like `ls --hyperlink` put a unique link on every line. Instead, we only remember them as candidates
+    // and sweep them all at once after a number of them proportional to the buffer height has piled up.
+    // That amortizes the cost of each sweep down to a few row walks per recycled link.
+    static constexpr size_t pruneRatio = 16;
+
+    for (const auto& run : GetRowByOffset(0).Attributes().runs())
+    {
+        const auto id = run.value.GetHyperlinkId();
+        if (id != 0 && id < _hyperlinks.size())
+        {
+            auto& entry = til::at(_hyperlinks, id);
+            if (entry.allocated && !entry.pendingPrune)
             {
-                // No more hyperlink references left to search for, terminate early
-                break;
+                entry.pendingPrune = true;
+                _hyperlinkPruneCandidates.emplace_back(id);
             }
         }
+    }
+
+    if (_hyperlinkPruneCandidates.size() * pruneRatio >= gsl::narrow_cast<size_t>(TotalRowCount()))
+    {
+        // The first row is about to be recycled, so its references don't count anymore.
+        _SweepHyperlinks(1);
+    }
+}
+
+// Removes all prune candidates that aren't referenced by any of the rows starting at firstRow
+// (or the current and DECSC saved attributes, since those will be used for later writes) from the hyperlink table.
+void TextBuffer::_SweepHyperlinks(const til::CoordType firstRow) noexcept
+{
+    if (_hyperlinkPruneCandidates.empty())
+    {
+        return;
+    }
 
-        // Now delete obsolete references from our map
-        for (auto hyperlinkReference : firstRowRefs)
+    const auto unmark = [&](const TextAttribute& attr) noexcept {
+        const auto id = attr.GetHyperlinkId();
+        if (id < _hyperlinks.size())
         {
-            RemoveHyperlinkFromMap(hyperlinkReference);
+            til::at(_hyperlinks, id).pendingPrune = false;
+        }
+    };
+
+    unmark(_currentAttributes);
+    unmark(_savedAttributes);
+
+    const auto total = TotalRowCount();
+    for (auto y = firstRow; y < total; ++y)
+    {
+        for (const auto& run : GetRowByOffset(y).Attributes().runs())
+        {
+            unmark(run.value);
+        }
+    }
+
+    for (const auto id : _hyperlinkPruneCandidates)
+    {
+        if (til::at(_hyperlinks, id).pendingPrune)
+        {
+            RemoveHyperlinkFromMap(id);
         }
     }
+
+    _hyperlinkPruneCandidates.clear();
 }
 
 // Method Description:
@@ -1886,37 +2058,100 @@ std::tuple<til::CoordType, til::CoordType, bool> TextBuffer::_RowCopyHelper(cons
 }
 
 // Routine Description:
-// - Retrieves the text data from the buffer and presents it in a clipboard-ready format.
+// - Collects the pieces of text that GetPlainText() returns: The text of each
+//   row in the copy request, each optionally followed by a line break.
+// - The pieces point into the rows, so they're only valid until the buffer is modified.
 // Arguments:
 // - req - the copy request having the bounds of the selected region and other related configuration flags.
+// - spans - receives the pieces of text.
 // Return Value:
-// - The text data from the selected region of the text buffer. Empty if the copy request is invalid.
-std::wstring TextBuffer::GetPlainText(const CopyRequest& req) const
+// - The total length of the pieces in characters.
+size_t TextBuffer::_PlainTextSpans(const CopyRequest& req, std::vector<std::wstring_view>& spans) const
 {
+    static constexpr std::wstring_view lineBreak{ L"\r\n" };
+
+    spans.clear();
     if (req.beg > req.end)
     {
-        return {};
+        return 0;
     }
 
-    std::wstring selectedText;
+    spans.reserve(gsl::narrow_cast<size_t>(req.end.y - req.beg.y + 1) * 2);
 
+    size_t length = 0;
     for (auto iRow = req.beg.y; iRow <= req.end.y; ++iRow)
     {
         const auto& row = GetRowByOffset(iRow);
         const auto& [rowBeg, rowEnd, addLineBreak] = _RowCopyHelper(req, iRow, row);
+        const auto text = row.GetText(rowBeg, rowEnd);
 
-        // save selected text
-        selectedText += row.GetText(rowBeg, rowEnd);
+        if (!text.empty())
+        {
+            spans.emplace_back(text);
+            length += text.size();
+        }
 
         if (addLineBreak && iRow != req.end.y)
         {
-            selectedText += L"\r\n";
+            spans.emplace_back(lineBreak);
+            length += lineBreak.size();
         }
     }
 
+    return length;
+}
+
+// Routine Description:
+// - Retrieves the text data from the buffer and presents it in a clipboard-ready format.
+// Arguments:
+// - req - the copy request having the bounds of the selected region and other related configuration flags.
+// Return Value:
+// - The text data from the selected region of the text buffer. Empty if the copy request is invalid.
+std::wstring TextBuffer::GetPlainText(const CopyRequest& req) const
+{
+    std::vector<std::wstring_view> spans;
+    const auto length = _PlainTextSpans(req, spans);
+
+    // The length is known upfront, so that the result can be built with a single allocation.
+    std::wstring selectedText;
+    selectedText.reserve(length);
+    for (const auto& span : spans)
+    {
+        selectedText.append(span);
+    }
+
     return selectedText;
 }
 
+// Routine Description:
+// - Same as GetPlainText(req), but writes the text into a caller-provided buffer.
+//   If the buffer is too small, the text is truncated to its size.
+//   Pass an empty buffer to only measure the text.
+// Arguments:
+// - req - the copy request having the bounds of the selected region and other related configuration flags.
+// - buffer - the destination for the text. The result isn't null-terminated.
+// Return Value:
+// - The length of the entire text, which may be larger than the buffer.
+size_t TextBuffer::GetPlainText(const CopyRequest& req, std::span<wchar_t> buffer) const
+{
+    std::vector<std::wstring_view> spans;
+    const auto length = _PlainTextSpans(req, spans);
+
+    auto remaining = buffer;
+    for (const auto& span : spans)
+    {
+        const auto count = std::min(span.size(), remaining.size());
+        std::copy_n(span.data(), count, remaining.data());
+        remaining = remaining.subspan(count);
+        if (remaining.empty())
+        {
+            break;
+        }
+    }
+
+    return length;
+}
+
 // Routine Description:
 // - Generates a CF_HTML compliant structure from the selected region of the buffer
 // Arguments:
@@ -2372,6 +2607,23 @@ void TextBuffer::Serialize(const wchar_t* destination) const
     {
         const auto& row = GetRowByOffset(currentRow);
 
+        // Every now and then, reset all attributes at the start of a line, so that
+        // FindSerializeResyncPoint() can skip everything that precedes it.
+        // No other code here emits "\x1b[0m", which makes it easy to find.
+        if (delayedLineBreak && currentRow % SerializeResyncInterval == 0)
+        {
+            if (previousHyperlinkId)
+            {
+                buffer.append(L"\x1b]8;;\x1b\\");
+            }
+            buffer.append(SerializeResyncSequence);
+            previousAttr = CharacterAttributes::Unused1;
+            previousFg = {};
+            previousBg = {};
+            previousUl = {};
+            previousHyperlinkId = 0;
+        }
+
         if (const auto lr = row.GetLineRendition(); lr != LineRendition::SingleWidth)
         {
             static constexpr std::wstring_view mappings[] = {
@@ -2635,6 +2887,36 @@ void TextBuffer::Serialize(const wchar_t* destination) const
     }
 }
 
+// Searches the output of Serialize() (or the tail end of it) back to front for the last resync point that's
+// followed by more lines than a buffer with the given number of rows can hold. Everything before it would be
+// scrolled out of such a buffer anyway and doesn't need to be restored. If there's no such resync point,
+// the prologue is empty and the remainder is the entire text.
+TextBuffer::SerializeResyncPoint TextBuffer::FindSerializeResyncPoint(const std::wstring_view text, const til::CoordType rows) noexcept
+{
+    const auto rowCount = gsl::narrow_cast<size_t>(std::max(0, rows));
+    size_t lines = 0;
+
+    for (auto i = text.size(); i-- > 0;)
+    {
+        const auto ch = til::at(text, i);
+        if (ch == L'\n')
+        {
+            lines++;
+        }
+        // The resync sequence is emitted in front of the line break that precedes its row. We cut that line break out,
+        // or otherwise we'd restore an additional empty line at the top. That's also why we need one more line than rows.
+        else if (ch == SerializeResyncSequence.front() && lines > rowCount && text.substr(i).starts_with(SerializeResyncSequence))
+        {
+            if (const auto lineBreak = text.find(L"\r\n", i); lineBreak != std::wstring_view::npos)
+            {
+                return { text.substr(i, lineBreak - i), text.substr(lineBreak + 2) };
+            }
+        }
+    }
+
+    return { {}, text };
+}
+
 // Function Description:
 // - Reflow the contents from the old buffer into the new buffer. The new buffer
 //   can have different dimensions than the old buffer. If it does, then this
@@ -2898,7 +3180,22 @@ void TextBuffer::Reflow(TextBuffer& oldBuffer, TextBuffer& newBuffer, const View
 // - The hyperlink URI, the hyperlink id (could be new or old)
 void TextBuffer::AddHyperlinkToMap(std::wstring_view uri, uint16_t id)
 {
-    _hyperlinkMap[id] = uri;
+    if (id == 0 || id >= _hyperlinks.size())
+    {
+        return;
+    }
+
+    auto& entry = til::at(_hyperlinks, id);
+    if (entry.uri && *entry.uri == uri)
+    {
+        return;
+    }
+
+    // Intern the new URI before releasing the old one, in case they share the same string.
+    const auto it = _hyperlinkUris.try_emplace(std::wstring{ uri }, 0).first;
+    it->second++;
+    _ReleaseHyperlinkUri(entry.uri);
+    entry.uri = &it->first;
 }
 
 // Method Description:
@@ -2906,10 +3203,17 @@ void TextBuffer::AddHyperlinkToMap(std::wstring_view uri, uint16_t id)
 // Arguments:
 // - The hyperlink ID
 // Return Value:
-// - The URI
+// - The URI, or an empty string if the ID is unknown
 std::wstring TextBuffer::GetHyperlinkUriFromId(uint16_t id) const
 {
-    return _hyperlinkMap.at(id);
+    if (id < _hyperlinks.size())
+    {
+        if (const auto uri = til::at(_hyperlinks, id).uri)
+        {
+            return *uri;
+        }
+    }
+    return {};
 }
 
 // Method description:
@@ -2917,36 +3221,98 @@ std::wstring TextBuffer::GetHyperlinkUriFromId(uint16_t id) const
 // Arguments:
 // - The user-defined id
 // Return value:
-// - The internal hyperlink ID
+// - The internal hyperlink ID, or 0 if the hyperlink table is exhausted
 uint16_t TextBuffer::GetHyperlinkId(std::wstring_view uri, std::wstring_view id)
 {
-    uint16_t numericId = 0;
     if (id.empty())
     {
-        // no custom id specified, return our internal count
-        numericId = _currentHyperlinkId;
-        ++_currentHyperlinkId;
+        // no custom id specified, return a fresh internal id
+        return _AllocateHyperlinkId();
     }
-    else
+
+    // hash the URL and add it to the custom ID - GH#7698
+    std::wstring newId{ id };
+    newId += L"%" + std::to_wstring(til::hash(uri));
+
+    if (const auto it = _hyperlinkCustomIdMap.find(newId); it != _hyperlinkCustomIdMap.end())
     {
-        // assign _currentHyperlinkId if the custom id does not already exist
-        std::wstring newId{ id };
-        // hash the URL and add it to the custom ID - GH#7698
-        newId += L"%" + std::to_wstring(til::hash(uri));
-        const auto result = _hyperlinkCustomIdMap.emplace(newId, _currentHyperlinkId);
-        if (result.second)
+        return it->second;
+    }
+
+    const auto numericId = _AllocateHyperlinkId();
+    if (numericId != 0)
+    {
+        til::at(_hyperlinks, numericId).customId = newId;
+        _hyperlinkCustomIdMap.emplace(std::move(newId), numericId);
+    }
+    return numericId;
+}
+
+// Hands out an unused hyperlink id. Pruned ids are reused once they've sat in the free list for
+// hyperlinkQuarantine frees, which keeps the slab about as large as the number of live hyperlinks.
+// Returns 0 if all 65535 ids are referenced by the buffer.
+uint16_t TextBuffer::_AllocateHyperlinkId()
+{
+    static constexpr size_t maxIds = size_t{ std::numeric_limits<uint16_t>::max() } + 1;
+
+    if (_hyperlinks.empty())
+    {
+        // Slot 0 is the "no hyperlink" id and never handed out.
+        _hyperlinks.emplace_back();
+    }
+
+    if (_hyperlinks.size() >= maxIds && _hyperlinkFreeCount == 0)
+    {
+        // We ran out of ids. Check every single one of them for whether it's still in use.
+        // This also collects ids that were handed out, but never ended up in the buffer.
+        _hyperlinkPruneCandidates.clear();
+        for (uint16_t id = 1; id < _hyperlinks.size(); ++id)
+        {
+            auto& entry = til::at(_hyperlinks, id);
+            entry.pendingPrune = entry.allocated;
+            if (entry.allocated)
+            {
+                _hyperlinkPruneCandidates.emplace_back(id);
+            }
+        }
+        _SweepHyperlinks(0);
+    }
+
+    uint16_t id = 0;
+    if (_hyperlinkFreeCount > hyperlinkQuarantine || (_hyperlinkFreeCount != 0 && _hyperlinks.size() >= maxIds))
+    {
+        id = _hyperlinkFreeHead;
+        _hyperlinkFreeHead = std::exchange(til::at(_hyperlinks, id).nextFree, uint16_t{ 0 });
+        if (--_hyperlinkFreeCount == 0)
         {
-            // the custom id did not already exist
-            ++_currentHyperlinkId;
+            _hyperlinkFreeTail = 0;
         }
-        numericId = (*(result.first)).second;
     }
-    // _currentHyperlinkId could overflow, make sure its not 0
-    if (_currentHyperlinkId == 0)
+    else if (_hyperlinks.size() < maxIds)
     {
-        ++_currentHyperlinkId;
+        id = gsl::narrow_cast<uint16_t>(_hyperlinks.size());
+        _hyperlinks.emplace_back();
+    }
+    else
+    {
+        return 0;
+    }
+
+    til::at(_hyperlinks, id).allocated = true;
+    return id;
+}
+
+// Decrements the reference count of an interned URI and frees it once it's unused.
+void TextBuffer::_ReleaseHyperlinkUri(const std::wstring* uri) noexcept
+{
+    if (!uri)
+    {
+        return;
+    }
+    if (const auto it = _hyperlinkUris.find(*uri); it != _hyperlinkUris.end() && --it->second == 0)
+    {
+        _hyperlinkUris.erase(it);
     }
-    return numericId;
 }
 
 // Method Description:
@@ -2956,15 +3322,35 @@ uint16_t TextBuffer::GetHyperlinkId(std::wstring_view uri, std::wstring_view id)
 // - The ID of the hyperlink to be removed
 void TextBuffer::RemoveHyperlinkFromMap(uint16_t id) noexcept
 {
-    _hyperlinkMap.erase(id);
-    for (const auto& customIdPair : _hyperlinkCustomIdMap)
+    if (id == 0 || id >= _hyperlinks.size())
     {
-        if (customIdPair.second == id)
-        {
-            _hyperlinkCustomIdMap.erase(customIdPair.first);
-            break;
-        }
+        return;
+    }
+
+    auto& entry = til::at(_hyperlinks, id);
+    if (!entry.allocated)
+    {
+        return;
+    }
+
+    if (!entry.customId.empty())
+    {
+        _hyperlinkCustomIdMap.erase(entry.customId);
     }
+    _ReleaseHyperlinkUri(entry.uri);
+    entry = {};
+
+    // Append the id to the end of the free list.
+    if (_hyperlinkFreeCount == 0)
+    {
+        _hyperlinkFreeHead = id;
+    }
+    else
+    {
+        til::at(_hyperlinks, _hyperlinkFreeTail).nextFree = id;
+    }
+    _hyperlinkFreeTail = id;
+    _hyperlinkFreeCount++;
 }
 
 // Method Description:
@@ -2976,26 +3362,36 @@ void TextBuffer::RemoveHyperlinkFromMap(uint16_t id) noexcept
 // - The custom ID if there was one, empty string otherwise
 std::wstring TextBuffer::GetCustomIdFromId(uint16_t id) const
 {
-    for (auto customIdPair : _hyperlinkCustomIdMap)
+    if (id < _hyperlinks.size())
     {
-        if (customIdPair.second == id)
-        {
-            return customIdPair.first;
-        }
+        return til::at(_hyperlinks, id).customId;
     }
     return {};
 }
 
 // Method Description:
-// - Copies the hyperlink/customID maps of the old buffer into this one,
-//   also copies currentHyperlinkId
+// - Copies the hyperlink/customID maps of the old buffer into this one
 // Arguments:
 // - The other buffer
 void TextBuffer::CopyHyperlinkMaps(const TextBuffer& other)
 {
-    _hyperlinkMap = other._hyperlinkMap;
+    _hyperlinks = other._hyperlinks;
+    _hyperlinkFreeHead = other._hyperlinkFreeHead;
+    _hyperlinkFreeTail = other._hyperlinkFreeTail;
+    _hyperlinkFreeCount = other._hyperlinkFreeCount;
+    _hyperlinkPruneCandidates = other._hyperlinkPruneCandidates;
+    _hyperlinkUris = other._hyperlinkUris;
     _hyperlinkCustomIdMap = other._hyperlinkCustomIdMap;
-    _currentHyperlinkId = other._currentHyperlinkId;
+    _savedAttributes = other._savedAttributes;
+
+    // The interned URI pointers still point into the other buffer's table.
+    for (auto& entry : _hyperlinks)
+    {
+        if (entry.uri)
+        {
+            entry.uri = &_hyperlinkUris.find(*entry.uri)->first;
+        }
+    }
 }
 
 // Searches through the entire (committed) text buffer for `needle` and returns the coordinates in absolute coordinates.
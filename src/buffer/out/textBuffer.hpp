@@ -54,6 +54,8 @@ filling in the last row, and updating the screen.
 #include "TextAttribute.hpp"
 #include "../types/inc/Viewport.hpp"
 
+#include <til/virtual_memory.h>
+
 #include "../buffer/out/textBufferCellIterator.hpp"
 #include "../buffer/out/textBufferTextIterator.hpp"
 
@@ -135,6 +137,7 @@ public:
     const Microsoft::Console::Types::Viewport GetSize() const noexcept;
 
     void ScrollRows(const til::CoordType firstRow, const til::CoordType size, const til::CoordType delta);
+    void RotateRows(const til::CoordType firstRow, til::CoordType size, const til::CoordType delta, const TextAttribute& fillAttributes);
     void CopyRow(const til::CoordType srcRow, const til::CoordType dstRow, TextBuffer& dstBuffer) const;
 
     til::CoordType TotalRowCount() const noexcept;
@@ -142,8 +145,20 @@ public:
     const TextAttribute& GetCurrentAttributes() const noexcept;
 
     void SetCurrentAttributes(const TextAttribute& currentAttributes) noexcept;
+    void SetSavedAttributes(const TextAttribute& savedAttributes) noexcept;
 
     void SetWrapForced(til::CoordType y, bool wrap);
+
+    // Replaces the attributes of all cells within rect with func(attribute). See ROW::TransformAttributes.
+    template<typename Func>
+    void TransformAttributes(const til::rect& rect, Func&& func)
+    {
+        for (auto y = rect.top; y < rect.bottom; ++y)
+        {
+            GetMutableRowByOffset(y).TransformAttributes(rect.left, rect.right, func);
+        }
+    }
+
     void SetCurrentLineRendition(const LineRendition lineRendition, const TextAttribute& fillAttributes);
     void ResetLineRenditionRange(const til::CoordType startRow, const til::CoordType endRow);
     LineRendition GetLineRendition(const til::CoordType row) const;
@@ -265,6 +280,7 @@ public:
     };
 
     std::wstring GetPlainText(const CopyRequest& req) const;
+    size_t GetPlainText(const CopyRequest& req, std::span<wchar_t> buffer) const;
 
     std::string GenHTML(const CopyRequest& req,
                         const int fontHeightPoints,
@@ -280,8 +296,21 @@ public:
                        const bool isIntenseBold,
                        std::function<std::tuple<COLORREF, COLORREF, COLORREF>(const TextAttribute&)> GetAttributeColors) const noexcept;
 
+    // Every SerializeResyncInterval rows Serialize() resets all attributes with SerializeResyncSequence
+    // at the start of a line. Restoring the file from there on yields the same rows as restoring all of it.
+    static constexpr std::wstring_view SerializeResyncSequence{ L"\x1b[0m" };
+    static constexpr til::CoordType SerializeResyncInterval = 256;
     void Serialize(const wchar_t* destination) const;
 
+    // The output of Serialize() split at a resync point. Writing the prologue followed by the remainder
+    // restores the same rows as writing all of the output, except for those that precede the resync point.
+    struct SerializeResyncPoint
+    {
+        std::wstring_view prologue;
+        std::wstring_view remainder;
+    };
+    static SerializeResyncPoint FindSerializeResyncPoint(std::wstring_view text, til::CoordType rows) noexcept;
+
     struct PositionInformation
     {
         til::CoordType mutableViewportTop{ 0 };
@@ -311,11 +340,13 @@ private:
     void _reserve(til::size screenBufferSize, const TextAttribute& defaultAttributes);
     void _commit(const std::byte* row);
     void _decommit() noexcept;
+    void _recycle() noexcept;
     void _construct(const std::byte* until) noexcept;
     void _destroy() const noexcept;
     ROW& _getRowByOffsetDirect(size_t offset);
     ROW& _getRow(til::CoordType y) const;
     til::CoordType _estimateOffsetOfLastCommittedRow() const noexcept;
+    void _rotateRows(til::CoordType firstRow, til::CoordType size, til::CoordType delta);
 
     void _SetFirstRowIndex(const til::CoordType FirstRowIndex) noexcept;
     void _ExpandTextRow(til::inclusive_rect& selectionRow) const;
@@ -325,20 +356,43 @@ private:
     til::point _GetWordEndForAccessibility(const til::point target, const std::wstring_view wordDelimiters, const til::point limit) const;
     til::point _GetWordEndForSelection(const til::point target, const std::wstring_view wordDelimiters) const;
     void _PruneHyperlinks();
+    void _SweepHyperlinks(til::CoordType firstRow) noexcept;
+    uint16_t _AllocateHyperlinkId();
+    void _ReleaseHyperlinkUri(const std::wstring* uri) noexcept;
 
     std::wstring _commandForRow(const til::CoordType rowOffset, const til::CoordType bottomInclusive, const bool clipAtCursor = false) const;
     MarkExtents _scrollMarkExtentForRow(const til::CoordType rowOffset, const til::CoordType bottomInclusive) const;
     bool _createPromptMarkIfNeeded();
 
     std::tuple<til::CoordType, til::CoordType, bool> _RowCopyHelper(const CopyRequest& req, const til::CoordType iRow, const ROW& row) const;
+    size_t _PlainTextSpans(const CopyRequest& req, std::vector<std::wstring_view>& spans) const;
 
     static void _AppendRTFText(std::string& contentBuilder, const std::wstring_view& text);
 
     Microsoft::Console::Render::Renderer* _renderer = nullptr;
 
-    std::unordered_map<uint16_t, std::wstring> _hyperlinkMap;
+    // Hyperlinks are stored in a slab indexed by their id (id 0 means "no hyperlink" and is never handed out).
+    // URIs are interned in _hyperlinkUris, which maps each URI to the number of entries referencing it,
+    // because tools like `ls --hyperlink` tend to emit the same few URIs over and over again.
+    // Ids of pruned entries are queued up in a FIFO free list that's threaded through the slab. They're reused
+    // in the order they were freed, but only once hyperlinkQuarantine newer ones have been freed after them,
+    // so that an id isn't recycled right away while something outside of the buffer may still refer to it.
+    struct HyperlinkEntry
+    {
+        const std::wstring* uri = nullptr; // points at a key in _hyperlinkUris
+        std::wstring customId; // key in _hyperlinkCustomIdMap, if any
+        uint16_t nextFree = 0; // the next id in the free list, if this one is in it
+        bool allocated = false;
+        bool pendingPrune = false;
+    };
+    static constexpr size_t hyperlinkQuarantine = 256;
+    std::vector<HyperlinkEntry> _hyperlinks;
+    uint16_t _hyperlinkFreeHead = 0;
+    uint16_t _hyperlinkFreeTail = 0;
+    size_t _hyperlinkFreeCount = 0;
+    std::vector<uint16_t> _hyperlinkPruneCandidates;
+    std::unordered_map<std::wstring, size_t> _hyperlinkUris;
     std::unordered_map<std::wstring, uint16_t> _hyperlinkCustomIdMap;
-    uint16_t _currentHyperlinkId = 1;
 
     // This block describes the state of the underlying virtual memory buffer that holds all ROWs, text and attributes.
     // Initially memory is only allocated with MEM_RESERVE to reduce the private working set of conhost.
@@ -353,7 +407,7 @@ private:
     // Padding may exist for alignment purposes.
     //
     // The base (start) address of the memory arena.
-    wil::unique_virtualalloc_ptr<std::byte> _buffer;
+    til::virtual_memory _buffer;
     // The past-the-end pointer of the memory arena.
     std::byte* _bufferEnd = nullptr;
     // The range between _buffer (inclusive) and _commitWatermark (exclusive) is the range of
@@ -372,7 +426,10 @@ private:
     // In other words, _commitWatermark itself will either point exactly onto the next ROW
     // that should be committed or be equal to _bufferEnd when all ROWs are committed.
     std::byte* _commitWatermark = nullptr;
-    // This will MEM_COMMIT 128 rows more than we need, to avoid us from having to call VirtualAlloc too often.
+    // The number of bytes starting at _buffer that are MEM_COMMITted. This is usually the same as
+    // _commitWatermark - _buffer, but may be more if the arena was recycled from a previous TextBuffer.
+    size_t _bufferCommitted = 0;
+    // This will MEM_COMMIT at least 128 rows more than we need, to avoid us from having to call VirtualAlloc too often.
     // This equates to roughly the following commit chunk sizes at these column counts:
     // *  80 columns (the usual minimum) =  60KB chunks,  4.1MB buffer at 9001 rows
     // * 120 columns (the most common)   =  80KB chunks,  5.6MB buffer at 9001 rows
@@ -380,6 +437,12 @@ private:
     // There's probably a better metric than this. (This comment was written when ROW had both,
     // a _chars array containing text and a _charOffsets array contain column-to-text indices.)
     static constexpr size_t _commitReadAheadRowCount = 128;
+    // If output streams into the buffer fast enough that we need to commit again within _commitReadAheadInterval,
+    // the read-ahead doubles (up to _commitReadAheadRowCountMax rows), because we'll most likely need it soon anyway.
+    static constexpr size_t _commitReadAheadRowCountMax = 4096;
+    static constexpr std::chrono::milliseconds _commitReadAheadInterval{ 100 };
+    size_t _commitReadAheadRows = _commitReadAheadRowCount;
+    std::chrono::steady_clock::time_point _lastCommit;
     // Before TextBuffer was made to use virtual memory it initialized the entire memory arena with the initial
     // attributes right away. To ensure it continues to work the way it used to, this stores these initial attributes.
     TextAttribute _initialAttributes;
@@ -398,6 +461,8 @@ private:
     uint16_t _height = 0;
 
     TextAttribute _currentAttributes;
+    // The attributes saved by DECSC. Only used to keep their hyperlink alive.
+    TextAttribute _savedAttributes;
     til::CoordType _firstRow = 0; // indexes top row (not necessarily 0)
     uint64_t _lastMutationId = 0;
 
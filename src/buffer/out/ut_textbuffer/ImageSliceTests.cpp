@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../textBuffer.hpp"
+#include "../../renderer/inc/DummyRenderer.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class ImageSliceTests
+{
+    TEST_CLASS(ImageSliceTests);
+
+    TEST_METHOD(CopyRowSharesPixels);
+    TEST_METHOD(CopyCellsSharesWholeSlice);
+    TEST_METHOD(CopyCellsCopiesPartialSlice);
+    TEST_METHOD(EraseCellsUnsharesPixels);
+
+    static constexpr til::size cellSize{ 10, 20 };
+    static constexpr RGBQUAD red{ .rgbRed = 255, .rgbReserved = 255 };
+    static constexpr RGBQUAD blue{ .rgbBlue = 255, .rgbReserved = 255 };
+
+    static bool _pixelEquals(const RGBQUAD& a, const RGBQUAD& b) noexcept
+    {
+        return memcmp(&a, &b, sizeof(RGBQUAD)) == 0;
+    }
+
+    static ImageSlice* _fillSlice(ROW& row, const til::CoordType columnBegin, const til::CoordType columnEnd, const RGBQUAD color)
+    {
+        auto slice = row.GetMutableImageSlice();
+        if (!slice)
+        {
+            slice = row.SetImageSlice(std::make_unique<ImageSlice>(cellSize));
+        }
+        const auto pixels = slice->MutablePixels(columnBegin, columnEnd);
+        for (auto y = 0; y < cellSize.height; y++)
+        {
+            std::fill_n(pixels + y * slice->PixelWidth(), (columnEnd - columnBegin) * cellSize.width, color);
+        }
+        return slice;
+    }
+};
+
+void ImageSliceTests::CopyRowSharesPixels()
+{
+    DummyRenderer renderer;
+    TextBuffer buffer{ til::size{ 20, 4 }, TextAttribute{}, 0, false, &renderer };
+    auto& srcRow = buffer.GetMutableRowByOffset(0);
+    auto& dstRow = buffer.GetMutableRowByOffset(1);
+    _fillSlice(srcRow, 2, 5, red);
+
+    Log::Comment(L"Copying a row shouldn't copy its pixels.");
+    ImageSlice::CopyRow(srcRow, dstRow);
+    VERIFY_IS_NOT_NULL(dstRow.GetImageSlice());
+    VERIFY_IS_TRUE(dstRow.GetImageSlice()->SharesPixelsWith(*srcRow.GetImageSlice()));
+
+    Log::Comment(L"Modifying the copy should leave the source unchanged.");
+    _fillSlice(dstRow, 2, 5, blue);
+    VERIFY_IS_FALSE(dstRow.GetImageSlice()->SharesPixelsWith(*srcRow.GetImageSlice()));
+    VERIFY_IS_TRUE(_pixelEquals(*srcRow.GetImageSlice()->Pixels(2), red));
+    VERIFY_IS_TRUE(_pixelEquals(*dstRow.GetImageSlice()->Pixels(2), blue));
+}
+
+void ImageSliceTests::CopyCellsSharesWholeSlice()
+{
+    DummyRenderer renderer;
+    TextBuffer buffer{ til::size{ 20, 4 }, TextAttribute{}, 0, false, &renderer };
+    auto& srcRow = buffer.GetMutableRowByOffset(0);
+    auto& dstRow = buffer.GetMutableRowByOffset(1);
+    _fillSlice(srcRow, 2, 5, red);
+    _fillSlice(dstRow, 4, 8, blue);
+
+    Log::Comment(L"A copy that covers the whole source and overwrites the whole destination can share pixels.");
+    ImageSlice::CopyCells(srcRow, 0, dstRow, 3, 20);
+    const auto dstSlice = dstRow.GetImageSlice();
+    VERIFY_IS_NOT_NULL(dstSlice);
+    VERIFY_IS_TRUE(dstSlice->SharesPixelsWith(*srcRow.GetImageSlice()));
+    VERIFY_ARE_EQUAL(5, dstSlice->ColumnOffset());
+    VERIFY_IS_TRUE(_pixelEquals(*dstSlice->Pixels(5), red));
+}
+
+void ImageSliceTests::CopyCellsCopiesPartialSlice()
+{
+    DummyRenderer renderer;
+    TextBuffer buffer{ til::size{ 20, 4 }, TextAttribute{}, 0, false, &renderer };
+    auto& srcRow = buffer.GetMutableRowByOffset(0);
+    auto& dstRow = buffer.GetMutableRowByOffset(1);
+    _fillSlice(srcRow, 2, 5, red);
+    _fillSlice(dstRow, 0, 10, blue);
+
+    Log::Comment(L"A copy that only overwrites part of the destination must merge the pixels.");
+    ImageSlice::CopyCells(srcRow, 2, dstRow, 6, 9);
+    const auto dstSlice = dstRow.GetImageSlice();
+    VERIFY_IS_NOT_NULL(dstSlice);
+    VERIFY_IS_FALSE(dstSlice->SharesPixelsWith(*srcRow.GetImageSlice()));
+    VERIFY_IS_TRUE(_pixelEquals(*dstSlice->Pixels(0), blue));
+    VERIFY_IS_TRUE(_pixelEquals(*dstSlice->Pixels(6), red));
+    VERIFY_IS_TRUE(_pixelEquals(*dstSlice->Pixels(9), blue));
+}
+
+void ImageSliceTests::EraseCellsUnsharesPixels()
+{
+    DummyRenderer renderer;
+    TextBuffer buffer{ til::size{ 20, 4 }, TextAttribute{}, 0, false, &renderer };
+    auto& srcRow = buffer.GetMutableRowByOffset(0);
+    auto& dstRow = buffer.GetMutableRowByOffset(1);
+    _fillSlice(srcRow, 2, 5, red);
+    ImageSlice::CopyRow(srcRow, dstRow);
+
+    Log::Comment(L"Erasing part of a shared slice shouldn't affect the other rows.");
+    ImageSlice::EraseCells(dstRow, 2, 3);
+    VERIFY_IS_FALSE(dstRow.GetImageSlice()->SharesPixelsWith(*srcRow.GetImageSlice()));
+    VERIFY_IS_TRUE(_pixelEquals(*srcRow.GetImageSlice()->Pixels(2), red));
+    VERIFY_IS_TRUE(_pixelEquals(*dstRow.GetImageSlice()->Pixels(2), RGBQUAD{}));
+}
@@ -104,6 +104,20 @@ namespace TerminalAppLocalTests
                 VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"AAAAAABBBBBBCCC");
                 VERIFY_IS_FALSE(segments.GetAt(0).IsHighlighted());
             }
+            {
+                Log::Comment(L"Testing command name segmentation with non-ASCII filter with other case");
+                const auto nonAsciiItem{ winrt::make<winrt::TerminalApp::implementation::CommandLinePaletteItem>(L"Gro\u00DFe \u00C4nderung") };
+                const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(nonAsciiItem);
+                filteredCommand->_Filter = L"\u00E4n";
+                auto segments = filteredCommand->_computeHighlightedName().Segments();
+                VERIFY_ARE_EQUAL(segments.Size(), 3u);
+                VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"Gro\u00DFe ");
+                VERIFY_IS_FALSE(segments.GetAt(0).IsHighlighted());
+                VERIFY_ARE_EQUAL(segments.GetAt(1).TextSegment(), L"\u00C4n");
+                VERIFY_IS_TRUE(segments.GetAt(1).IsHighlighted());
+                VERIFY_ARE_EQUAL(segments.GetAt(2).TextSegment(), L"derung");
+                VERIFY_IS_FALSE(segments.GetAt(2).IsHighlighted());
+            }
         });
 
         VERIFY_SUCCEEDED(result);
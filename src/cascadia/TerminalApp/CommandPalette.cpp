@@ -1101,8 +1101,22 @@ namespace winrt::TerminalApp::implementation
         }
         else if (_currentMode == CommandPaletteMode::TabSearchMode || _currentMode == CommandPaletteMode::ActionMode || _currentMode == CommandPaletteMode::CommandlineMode)
         {
+            const std::wstring_view searchTextView{ searchText };
+
             for (const auto& action : commandsToFilter)
             {
+                // If the user only appended characters to the search text since this command was last
+                // filtered and it didn't match back then, it can't match now either. This narrows
+                // the number of commands we actually need to match with every keystroke.
+                if (action.Weight() == 0)
+                {
+                    const auto previousFilter = action.Filter();
+                    if (!previousFilter.empty() && searchTextView.starts_with(std::wstring_view{ previousFilter }))
+                    {
+                        continue;
+                    }
+                }
+
                 // Update filter for all commands
                 // This will modify the highlighting but will also lead to re-computation of weight (and consequently sorting).
                 // Pay attention that it already updates the highlighting in the UI
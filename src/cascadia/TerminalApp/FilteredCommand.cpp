@@ -37,6 +37,7 @@ namespace winrt::TerminalApp::implementation
         _Item = item;
         _Filter = L"";
         _Weight = 0;
+        _foldedName = _foldCase(_Item.Name());
         _HighlightedName = _computeHighlightedName();
 
         // Recompute the highlighted name if the item name changes
@@ -44,6 +45,8 @@ namespace winrt::TerminalApp::implementation
             auto filteredCommand{ weakThis.get() };
             if (filteredCommand && e.PropertyName() == L"Name")
             {
+                filteredCommand->_foldedName = _foldCase(filteredCommand->_Item.Name());
+                filteredCommand->_unmatchedName = nullptr;
                 filteredCommand->HighlightedName(filteredCommand->_computeHighlightedName());
                 filteredCommand->Weight(filteredCommand->_computeWeight());
             }
@@ -77,88 +80,109 @@ namespace winrt::TerminalApp::implementation
     //
     // E.g., ("CL", true) ("ose ", false), ("T", true), ("ab", false), ("S", true), ("after this", false)
     //
+    // GH#9941: search should be locale-aware as well. Both the filter and the name are lowercased with
+    // the user's locale, which allows us to search for each filter character with wstring_view::find().
+    // That one is vectorized and most items don't match, so we first check whether the filter
+    // matches at all and only then split the name into segments.
+    //
     // TODO: we probably need to merge this logic with _getWeight computation?
     //
     // Return Value:
     // - The HighlightedText object initialized with the segments computed according to the algorithm above.
     winrt::TerminalApp::HighlightedText FilteredCommand::_computeHighlightedName()
     {
-        const auto segments = winrt::single_threaded_observable_vector<winrt::TerminalApp::HighlightedTextSegment>();
-        auto commandName = _Item.Name();
-        auto isProcessingMatchedSegment = false;
-        uint32_t nextOffsetToReport = 0;
-        uint32_t currentOffset = 0;
+        const auto commandName = _Item.Name();
+        const auto filter = _foldCase(_Filter);
+
+        // _foldedName is updated whenever the name changes. This is just a safeguard
+        // against reading out of bounds, in case the two ever get out of sync.
+        if (_foldedName.size() != commandName.size())
+        {
+            _foldedName = _foldCase(commandName);
+        }
+
+        const std::wstring_view foldedName{ _foldedName };
 
-        for (const auto searchChar : _Filter)
         {
-            const WCHAR searchCharAsString[] = { searchChar, L'\0' };
-            while (true)
+            size_t offset = 0;
+            for (const auto searchChar : filter)
             {
-                if (currentOffset == commandName.size())
+                offset = foldedName.find(searchChar, offset);
+                if (offset == std::wstring_view::npos)
                 {
                     // There are still unmatched filter characters but we finished scanning the name.
                     // In this case we return the entire item name as unmatched
-                    auto entireNameSegment{ winrt::make<HighlightedTextSegment>(commandName, false) };
-                    segments.Clear();
-                    segments.Append(entireNameSegment);
-                    return winrt::make<HighlightedText>(segments);
+                    return _unmatchedHighlightedName();
                 }
+                offset++;
+            }
+        }
 
-                // GH#9941: search should be locale-aware as well
-                // We use the same comparison method as upon sorting to guarantee consistent behavior
-                const WCHAR currentCharAsString[] = { commandName[currentOffset], L'\0' };
-                auto isCurrentCharMatched = lstrcmpi(searchCharAsString, currentCharAsString) == 0;
-                if (isProcessingMatchedSegment != isCurrentCharMatched)
-                {
-                    // We reached the end of the region (matched character came after a series of unmatched or vice versa).
-                    // Conclude the segment and add it to the list.
-                    // Skip segment if it is empty (might happen when the first character of the name is matched)
-                    auto sizeToReport = currentOffset - nextOffsetToReport;
-                    if (sizeToReport > 0)
-                    {
-                        winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-                        auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, isProcessingMatchedSegment) };
-                        segments.Append(highlightedSegment);
-                        nextOffsetToReport = currentOffset;
-                    }
-                    isProcessingMatchedSegment = isCurrentCharMatched;
-                }
+        const auto segments = winrt::single_threaded_observable_vector<winrt::TerminalApp::HighlightedTextSegment>();
+        const auto appendSegment = [&](size_t beg, size_t end, bool isHighlighted) {
+            if (beg < end)
+            {
+                winrt::hstring segment{ commandName.data() + beg, gsl::narrow_cast<uint32_t>(end - beg) };
+                segments.Append(winrt::make<HighlightedTextSegment>(segment, isHighlighted));
+            }
+        };
 
-                currentOffset++;
+        // [matchBeg, matchEnd) is the current run of consecutively matched characters
+        // and nextOffsetToReport is the start of the text that hasn't been turned into a segment yet.
+        size_t nextOffsetToReport = 0;
+        size_t matchBeg = 0;
+        size_t matchEnd = 0;
 
-                if (isCurrentCharMatched)
-                {
-                    // We have matched this filter character, let's move to matching the next filter char
-                    break;
-                }
+        for (const auto searchChar : filter)
+        {
+            const auto offset = foldedName.find(searchChar, matchEnd);
+            if (offset != matchEnd)
+            {
+                // We reached the end of the matched region. Conclude the segments and add them to the list.
+                appendSegment(nextOffsetToReport, matchBeg, false);
+                appendSegment(matchBeg, matchEnd, true);
+                nextOffsetToReport = matchEnd;
+                matchBeg = offset;
             }
+            matchEnd = offset + 1;
         }
 
         // Either the filter or the item name were fully processed.
         // If we were in the middle of the matched segment - add it.
-        if (isProcessingMatchedSegment)
-        {
-            auto sizeToReport = currentOffset - nextOffsetToReport;
-            if (sizeToReport > 0)
-            {
-                winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-                auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, true) };
-                segments.Append(highlightedSegment);
-                nextOffsetToReport = currentOffset;
-            }
-        }
+        appendSegment(nextOffsetToReport, matchBeg, false);
+        appendSegment(matchBeg, matchEnd, true);
 
         // Now create a segment for all remaining characters.
         // We will have remaining characters as long as the filter is shorter than the item name.
-        auto sizeToReport = commandName.size() - nextOffsetToReport;
-        if (sizeToReport > 0)
+        appendSegment(matchEnd, commandName.size(), false);
+
+        return winrt::make<HighlightedText>(segments);
+    }
+
+    // Returns the HighlightedText used for items that don't match the filter. It's the entire
+    // name as a single segment and since that doesn't depend on the filter we only create it once.
+    winrt::TerminalApp::HighlightedText FilteredCommand::_unmatchedHighlightedName()
+    {
+        if (!_unmatchedName)
         {
-            winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-            auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, false) };
-            segments.Append(highlightedSegment);
+            const auto segments = winrt::single_threaded_observable_vector<winrt::TerminalApp::HighlightedTextSegment>();
+            segments.Append(winrt::make<HighlightedTextSegment>(_Item.Name(), false));
+            _unmatchedName = winrt::make<HighlightedText>(segments);
         }
+        return _unmatchedName;
+    }
 
-        return winrt::make<HighlightedText>(segments);
+    // Lowercases the given string with the user's locale. LCMAP_LOWERCASE maps each UTF-16
+    // code unit to exactly one code unit, so offsets into the result are valid for the input.
+    std::wstring FilteredCommand::_foldCase(const std::wstring_view str)
+    {
+        std::wstring folded{ str };
+        if (!folded.empty())
+        {
+            const auto length = gsl::narrow<int>(str.size());
+            LOG_LAST_ERROR_IF(!LCMapStringEx(LOCALE_NAME_USER_DEFAULT, LCMAP_LOWERCASE | LCMAP_LINGUISTIC_CASING, str.data(), length, folded.data(), length, nullptr, nullptr, 0));
+        }
+        return folded;
     }
 
     // Function Description:
@@ -33,8 +33,15 @@ namespace winrt::TerminalApp::implementation
         void _constructFilteredCommand(const winrt::TerminalApp::PaletteItem& item);
 
     private:
+        static std::wstring _foldCase(const std::wstring_view str);
+
         winrt::TerminalApp::HighlightedText _computeHighlightedName();
+        winrt::TerminalApp::HighlightedText _unmatchedHighlightedName();
         int _computeWeight();
+
+        // The lowercased item name, which the filter is matched against.
+        std::wstring _foldedName;
+        winrt::TerminalApp::HighlightedText _unmatchedName{ nullptr };
         Windows::UI::Xaml::Data::INotifyPropertyChanged::PropertyChanged_revoker _itemChangedRevoker;
 
         friend class TerminalAppLocalTests::FilteredCommandTests;
@@ -711,6 +711,9 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
                 try
                 {
+                    // Passing the std::wstring (and not a winrt::hstring) is intentional: The delegates take a
+                    // param::hstring, which turns it into a fast-pass string that references `wstr` directly.
+                    // This hands the output to in-proc handlers like ControlCore without an allocation or copy.
                     TerminalOutput.raise(wstr);
                 }
                 CATCH_LOG();
@@ -1821,36 +1821,83 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             message = fmt::format(FMT_COMPILE(L"\x1b[100;37m  [{} {} {}]\x1b[K\x1b[m\r\n"), msg, date, time);
         }
 
-        wchar_t buffer[32 * 1024];
+        wchar_t bom = 0;
         DWORD read = 0;
 
         // Ensure the text file starts with a UTF-16 BOM.
-        if (!ReadFile(file.get(), &buffer[0], 2, &read, nullptr) || read < 2 || buffer[0] != L'\uFEFF')
+        if (!ReadFile(file.get(), &bom, 2, &read, nullptr) || read < 2 || bom != L'\uFEFF')
         {
             return;
         }
 
-        for (;;)
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file.get(), &fileSize))
         {
-            if (!ReadFile(file.get(), &buffer[0], sizeof(buffer), &read, nullptr))
+            return;
+        }
+
+        til::CoordType rows = 0;
+        {
+            const auto lock = _terminal->LockForReading();
+            rows = _terminal->GetTextBuffer().TotalRowCount();
+        }
+
+        // Anything that doesn't fit into our buffer would be scrolled out of it anyway.
+        // If the file is large enough, we only restore it from the last resync point that still fills
+        // the entire buffer. This way the viewport and as much history as we can hold are restored
+        // without having to parse (potentially many megabytes of) older history first.
+        // We don't know upfront how much of the file that is, so we read ever larger parts of its end.
+        const auto textLength = gsl::narrow<size_t>(fileSize.QuadPart / 2 - 1);
+        std::wstring text;
+        TextBuffer::SerializeResyncPoint restore;
+
+        for (auto length = std::min<size_t>(textLength, 256 * 1024);; length = std::min(textLength, length * 2))
+        {
+            LARGE_INTEGER distance{};
+            distance.QuadPart = gsl::narrow_cast<int64_t>((1 + textLength - length) * 2);
+            text.resize(length);
+            if (!SetFilePointerEx(file.get(), distance, nullptr, FILE_BEGIN) ||
+                !ReadFile(file.get(), text.data(), gsl::narrow<DWORD>(length * 2), &read, nullptr) ||
+                read != length * 2)
+            {
+                return;
+            }
+
+            restore = TextBuffer::FindSerializeResyncPoint(text, rows);
+            if (!restore.prologue.empty() || length == textLength)
             {
                 break;
             }
+        }
 
+        {
             const auto lock = _terminal->LockForWriting();
-            _terminal->Write({ &buffer[0], read / 2 });
+            _terminal->Write(restore.prologue);
+        }
 
-            if (read < sizeof(buffer))
+        // The lock is released every 32KB, so that the UI stays responsive while we're restoring.
+        static constexpr size_t chunkSize = 32 * 1024;
+        for (auto remainder = restore.remainder; !remainder.empty();)
+        {
+            auto count = std::min(remainder.size(), chunkSize);
+            // Don't split surrogate pairs across chunks.
+            if (count < remainder.size() && IS_HIGH_SURROGATE(remainder[count - 1]))
             {
-                // Normally the cursor should already be at the start of the line, but let's be absolutely sure it is.
-                if (_terminal->GetCursorPosition().x != 0)
-                {
-                    _terminal->Write(L"\r\n");
-                }
-                _terminal->Write(message);
-                break;
+                count--;
             }
+
+            const auto lock = _terminal->LockForWriting();
+            _terminal->Write(remainder.substr(0, count));
+            remainder = remainder.substr(count);
+        }
+
+        const auto lock = _terminal->LockForWriting();
+        // Normally the cursor should already be at the start of the line, but let's be absolutely sure it is.
+        if (_terminal->GetCursorPosition().x != 0)
+        {
+            _terminal->Write(L"\r\n");
         }
+        _terminal->Write(message);
     }
 
     void ControlCore::_rendererWarning(const HRESULT hr, wil::zwstring_view parameter)
@@ -2151,13 +2198,43 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         auto noticeArgs = winrt::make<NoticeEventArgs>(NoticeLevel::Info, RS_(L"TermControlReadOnly"));
         RaiseNotice.raise(*this, std::move(noticeArgs));
     }
+    // NOTE: For ConptyConnection `hstr` is a fast-pass string that references the connection's
+    // conversion buffer, which gets reused for the next read. It's only valid for the duration
+    // of this call and copying it means allocating a new string. So, don't hold on to it.
     void ControlCore::_connectionOutputHandler(const hstring& hstr)
     {
         try
         {
             {
-                const auto lock = _terminal->LockForWriting();
-                _terminal->Write(hstr);
+                // Large bursts of output are parsed in slices. If the render or UI thread are waiting
+                // for the lock in between two slices we briefly release it. The lock is fair,
+                // so they get to go first and don't stall until the entire burst has been parsed.
+                static constexpr size_t sliceLength = 16 * 1024;
+                std::wstring_view remaining{ hstr };
+                auto lock = _terminal->LockForWriting();
+
+                for (;;)
+                {
+                    auto count = std::min(remaining.size(), sliceLength);
+                    // Don't split surrogate pairs across slices.
+                    if (count < remaining.size() && IS_HIGH_SURROGATE(remaining[count - 1]))
+                    {
+                        count--;
+                    }
+
+                    _terminal->Write(remaining.substr(0, count));
+                    remaining = remaining.substr(count);
+
+                    if (remaining.empty())
+                    {
+                        break;
+                    }
+                    if (_terminal->IsLockContended())
+                    {
+                        lock.unlock();
+                        lock.lock();
+                    }
+                }
             }
 
             if (!_pendingResponses.empty())
@@ -502,17 +502,20 @@ std::wstring Terminal::GetHyperlinkAtBufferPosition(const til::point bufferPos)
     {
         // Hyperlink is outside of the current view.
         // We need to find if there's a pattern at that location.
-        const auto patterns = _getPatterns(bufferPos.y, bufferPos.y);
-
-        // NOTE: patterns is stored with top y-position being 0,
+        // NOTE: patterns are stored with top y-position being 0,
         //       so we need to cleverly set the y-pos to 0.
         const til::point viewportPos{ bufferPos.x, 0 };
-        const auto results = patterns.findOverlapping(viewportPos, viewportPos);
-        if (!results.empty())
+        for (const auto& interval : _getLinePatterns(bufferPos.y, bufferPos.y))
         {
-            result = results.front();
-            result->start.y += bufferPos.y;
-            result->stop.y += bufferPos.y;
+            // Intervals are half-open in x, just like in GetHyperlinkIntervalFromViewportPosition().
+            if (interval.start <= viewportPos && viewportPos < interval.stop)
+            {
+                result = interval;
+                result->stop.x--;
+                result->start.y += bufferPos.y;
+                result->stop.y += bufferPos.y;
+                break;
+            }
         }
     }
 
@@ -959,6 +962,14 @@ til::recursive_ticket_lock_suspension Terminal::SuspendLock() noexcept
     return _readWriteLock.suspend();
 }
 
+// Method Description:
+// - Returns true if another thread is waiting to acquire the terminal lock.
+//   Only meaningful while the calling thread is holding the lock.
+bool Terminal::IsLockContended() const noexcept
+{
+    return _readWriteLock.has_waiters();
+}
+
 Viewport Terminal::_GetMutableViewport() const noexcept
 {
     // GH#3493: if we're in the alt buffer, then it's possible that the mutable
@@ -1177,8 +1188,20 @@ void Terminal::SetCursorOn(const bool isOn) noexcept
 // - INVARIANT: this function can only be called if the caller has the writing lock on the terminal
 void Terminal::UpdatePatternsUnderLock()
 {
+    // Lines that haven't been seen since the previous update get evicted from the cache.
+    std::swap(_patternCache, _patternCachePrevious);
+    _patternCache.clear();
+
+    auto intervals = _getPatterns(_VisibleStartIndex(), _VisibleEndIndex());
+    if (intervals == _patternIntervals)
+    {
+        // Nothing moved, so there's no need to rebuild the tree or to redraw the patterns.
+        return;
+    }
+
     _InvalidatePatternTree();
-    _patternIntervalTree = _getPatterns(_VisibleStartIndex(), _VisibleEndIndex());
+    _patternIntervals = intervals;
+    _patternIntervalTree = PointTree{ std::move(intervals) };
     _InvalidatePatternTree();
 }
 
@@ -1194,6 +1217,9 @@ void Terminal::_clearPatternTree()
         _InvalidatePatternTree();
         _patternIntervalTree = {};
     }
+    _patternIntervals.clear();
+    _patternCache.clear();
+    _patternCachePrevious.clear();
 }
 
 // Method Description:
@@ -1426,18 +1452,77 @@ private:
 
 static URegularExpressionInterner uregexInterner;
 
-PointTree Terminal::_getPatterns(til::CoordType beg, til::CoordType end) const
+// Returns the pattern matches in rows [beg,end] in viewport-relative coordinates, i.e. with row `beg` being y=0.
+// The rows are split up into their wrapped lines, because no pattern can span across a newline, and each line
+// is looked up in _patternCache first. This way we only run the regexes over lines that are new or have changed.
+PointTree::interval_vector Terminal::_getPatterns(til::CoordType beg, til::CoordType end)
+{
+    PointTree::interval_vector intervals;
+
+    if (!_detectURLs)
+    {
+        return intervals;
+    }
+
+    const auto& buffer = _activeBuffer();
+
+    for (auto lineBeg = beg; lineBeg <= end;)
+    {
+        auto lineEnd = lineBeg;
+        while (lineEnd < end && buffer.GetRowByOffset(lineEnd).WasWrapForced())
+        {
+            lineEnd++;
+        }
+
+        const auto dy = lineBeg - beg;
+        for (auto interval : _getLinePatterns(lineBeg, lineEnd))
+        {
+            interval.start.y += dy;
+            interval.stop.y += dy;
+            intervals.emplace_back(interval);
+        }
+
+        lineBeg = lineEnd + 1;
+    }
+
+    return intervals;
+}
+
+// Returns the pattern matches in rows [beg,end] relative to row `beg`.
+// The results are cached by the contents of the rows, so the regexes only run on a cache miss.
+const PointTree::interval_vector& Terminal::_getLinePatterns(til::CoordType beg, til::CoordType end)
 {
     static constexpr std::array<std::wstring_view, 1> patterns{
         LR"(\b(?:https?|ftp|file)://[-A-Za-z0-9+&@#/%?=~_|$!:,.;]*[A-Za-z0-9+&@#/%=~_|$])",
     };
 
-    if (!_detectURLs)
+    const auto& buffer = _activeBuffer();
+
+    auto& text = _patternLineText;
+    text.clear();
+    for (auto y = beg; y <= end; ++y)
     {
-        return {};
+        text.append(buffer.GetRowByOffset(y).GetText());
+    }
+    // All rows but the last one are wrapped. The last one may be wrapped as well if the line continues below
+    // the given range, which changes what the patterns can match. Since every row contributes the same number
+    // of characters, the trailing newline can't be confused with the text of another line.
+    if (!buffer.GetRowByOffset(end).WasWrapForced())
+    {
+        text.push_back(L'\n');
+    }
+    const auto key = til::hash(text);
+
+    if (const auto it = _patternCache.find(key); it != _patternCache.end() && it->second.text == text)
+    {
+        return it->second.intervals;
+    }
+    if (const auto it = _patternCachePrevious.find(key); it != _patternCachePrevious.end() && it->second.text == text)
+    {
+        return _patternCache.insert_or_assign(key, std::move(it->second)).first->second.intervals;
     }
 
-    auto text = ICU::UTextFromTextBuffer(_activeBuffer(), beg, end + 1);
+    auto text = ICU::UTextFromTextBuffer(buffer, beg, end + 1);
     UErrorCode status = U_ZERO_ERROR;
     PointTree::interval_vector intervals;
 
@@ -1451,7 +1536,7 @@ PointTree Terminal::_getPatterns(til::CoordType beg, til::CoordType end) const
             do
             {
                 auto range = ICU::BufferRangeFromMatch(&text, re.get());
-                // PointTree uses half-open ranges and viewport-relative coordinates.
+                // PointTree uses half-open ranges and line-relative coordinates.
                 range.start.y -= beg;
                 range.end.y -= beg;
                 range.end.x++;
@@ -1460,7 +1545,8 @@ PointTree Terminal::_getPatterns(til::CoordType beg, til::CoordType end) const
         }
     }
 
-    return PointTree{ std::move(intervals) };
+    // On a hash collision this replaces the entry of the other line.
+    return _patternCache.insert_or_assign(key, PatternCacheEntry{ text, std::move(intervals) }).first->second.intervals;
 }
 
 // NOTE: This is the version of AddMark that comes from the UI. The VT api call into this too.
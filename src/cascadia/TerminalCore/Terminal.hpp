@@ -107,6 +107,7 @@ public:
     [[nodiscard]] std::unique_lock<til::recursive_ticket_lock> LockForReading() const noexcept;
     [[nodiscard]] std::unique_lock<til::recursive_ticket_lock> LockForWriting() noexcept;
     til::recursive_ticket_lock_suspension SuspendLock() noexcept;
+    bool IsLockContended() const noexcept;
 
     til::CoordType GetBufferHeight() const noexcept;
 
@@ -431,6 +432,20 @@ private:
     //      Either way, we should make this behavior controlled by a setting.
 
     interval_tree::IntervalTree<til::point, size_t> _patternIntervalTree;
+    // The intervals _patternIntervalTree was built from, so that we can skip rebuilding it if nothing changed.
+    interval_tree::IntervalTree<til::point, size_t>::interval_vector _patternIntervals;
+    // Pattern matches per (wrapped) line, keyed by a hash of the line's contents and relative to its first row.
+    // The contents are stored alongside, so that a hash collision can't return the matches of another line.
+    // Lines that weren't used during the last two calls to UpdatePatternsUnderLock() are evicted.
+    struct PatternCacheEntry
+    {
+        std::wstring text;
+        interval_tree::IntervalTree<til::point, size_t>::interval_vector intervals;
+    };
+    std::unordered_map<size_t, PatternCacheEntry> _patternCache;
+    std::unordered_map<size_t, PatternCacheEntry> _patternCachePrevious;
+    // Scratch buffer for the contents of the line that _getLinePatterns() looks up.
+    std::wstring _patternLineText;
     void _clearPatternTree();
     void _InvalidatePatternTree();
     void _InvalidateFromCoords(const til::point start, const til::point end);
@@ -467,7 +482,8 @@ private:
     bool _inAltBuffer() const noexcept;
     TextBuffer& _activeBuffer() const noexcept;
     void _updateUrlDetection();
-    interval_tree::IntervalTree<til::point, size_t> _getPatterns(til::CoordType beg, til::CoordType end) const;
+    interval_tree::IntervalTree<til::point, size_t>::interval_vector _getPatterns(til::CoordType beg, til::CoordType end);
+    const interval_tree::IntervalTree<til::point, size_t>::interval_vector& _getLinePatterns(til::CoordType beg, til::CoordType end);
 
 #pragma region TextSelection
     // These methods are defined in TerminalSelection.cpp
@@ -382,6 +382,7 @@ void Terminal::NotifyBufferRotation(const int delta)
 
     // manually erase our pattern intervals since the locations have changed now
     _patternIntervalTree = {};
+    _patternIntervals.clear();
 
     const auto oldScrollOffset = _scrollOffset;
     _PreserveUserScrollOffset(delta);
@@ -90,6 +90,30 @@ static auto extractValueFromTaskWithoutMainThreadAwait(TTask&& task) -> decltype
     return finalVal.value();
 }
 
+// Runs func(index) on a background thread and counts down the latch once it's done.
+template<typename Func>
+static safe_void_coroutine runInBackground(til::latch& latch, const Func& func, const size_t index)
+{
+    const auto cleanup = wil::scope_exit([&]() {
+        latch.count_down();
+    });
+    co_await winrt::resume_background();
+    func(index);
+}
+
+// Calls func(0) to func(count - 1) concurrently on the thread pool and waits for all of them to finish.
+// Each call should write its results into a slot of its own, so that they can be consumed in a deterministic order.
+template<typename Func>
+static void forEachConcurrently(const size_t count, const Func& func)
+{
+    til::latch latch{ gsl::narrow_cast<ptrdiff_t>(count) };
+    for (size_t i = 0; i < count; ++i)
+    {
+        runInBackground(latch, func, i);
+    }
+    latch.wait();
+}
+
 // Concatenates the two given strings (!) and returns them as a path.
 // You better make sure there's a path separator at the end of lhs or at the start of rhs.
 static std::filesystem::path buildPath(const std::wstring_view& lhs, const std::wstring_view& rhs)
@@ -160,13 +184,26 @@ SettingsLoader::SettingsLoader(const std::string_view& userJSON, const std::stri
 // (meaning profiles specified by the application rather by the user).
 void SettingsLoader::GenerateProfiles()
 {
-    _executeGenerator(PowershellCoreProfileGenerator{});
-    _executeGenerator(WslDistroGenerator{});
-    _executeGenerator(AzureCloudShellGenerator{});
-    _executeGenerator(VisualStudioGenerator{});
+    const PowershellCoreProfileGenerator powershellCoreGenerator{};
+    const WslDistroGenerator wslDistroGenerator{};
+    const AzureCloudShellGenerator azureCloudShellGenerator{};
+    const VisualStudioGenerator visualStudioGenerator{};
+#if TIL_FEATURE_DYNAMICSSHPROFILES_ENABLED
+    const SshHostGenerator sshHostGenerator{};
+#endif
+
+    // The order of this list determines the order of the generated profiles.
+    const IDynamicProfileGenerator* generators[]{
+        &powershellCoreGenerator,
+        &wslDistroGenerator,
+        &azureCloudShellGenerator,
+        &visualStudioGenerator,
 #if TIL_FEATURE_DYNAMICSSHPROFILES_ENABLED
-    _executeGenerator(SshHostGenerator{});
+        &sshHostGenerator,
 #endif
+    };
+
+    _executeGenerators(generators);
 }
 
 // A new settings.json gets a special treatment:
@@ -226,22 +263,23 @@ void SettingsLoader::MergeInboxIntoUserSettings()
 // Additionally the GUID in "updates" will conflict with existing GUIDs in .inboxSettings.
 void SettingsLoader::FindFragmentsAndMergeIntoUserSettings()
 {
-    ParsedSettings fragmentSettings;
+    struct FragmentFile
+    {
+        std::filesystem::path path;
+        winrt::hstring source;
+        std::optional<JsonSettings> json;
+    };
 
-    const auto parseAndLayerFragmentFiles = [&](const std::filesystem::path& path, const winrt::hstring& source) {
+    // We first gather all fragment files, then read and parse them concurrently,
+    // and finally layer them in the order in which they were found.
+    std::vector<FragmentFile> fragmentFiles;
+
+    const auto findFragmentFiles = [&](const std::filesystem::path& path, const winrt::hstring& source) {
         for (const auto& fragmentExt : std::filesystem::directory_iterator{ path })
         {
             if (fragmentExt.path().extension() == jsonExtension)
             {
-                try
-                {
-                    const auto content = til::io::read_file_as_utf8_string_if_exists(fragmentExt.path());
-                    if (!content.empty())
-                    {
-                        _parseFragment(source, content, fragmentSettings);
-                    }
-                }
-                CATCH_LOG();
+                fragmentFiles.emplace_back(FragmentFile{ fragmentExt.path(), source });
             }
         }
     };
@@ -262,7 +300,7 @@ void SettingsLoader::FindFragmentsAndMergeIntoUserSettings()
 
                 if (!_ignoredNamespaces.count(std::wstring_view{ source }) && fragmentExtFolder.is_directory())
                 {
-                    parseAndLayerFragmentFiles(fragmentExtFolder.path(), winrt::hstring{ source });
+                    findFragmentFiles(fragmentExtFolder.path(), winrt::hstring{ source });
                 }
             }
         }
@@ -287,36 +325,61 @@ void SettingsLoader::FindFragmentsAndMergeIntoUserSettings()
     }
     CATCH_LOG();
 
-    if (!extensions)
+    if (extensions)
     {
-        return;
-    }
-
-    for (const auto& ext : extensions)
-    {
-        const auto packageName = ext.Package().Id().FamilyName();
-        if (_ignoredNamespaces.count(std::wstring_view{ packageName }))
+        for (const auto& ext : extensions)
         {
-            continue;
+            const auto packageName = ext.Package().Id().FamilyName();
+            if (_ignoredNamespaces.count(std::wstring_view{ packageName }))
+            {
+                continue;
+            }
+
+            // Likewise, getting the public folder from an extension is an async operation.
+            auto foundFolder = extractValueFromTaskWithoutMainThreadAwait(ext.GetPublicFolderAsync());
+            if (!foundFolder)
+            {
+                continue;
+            }
+
+            // the StorageFolder class has its own methods for obtaining the files within the folder
+            // however, all those methods are Async methods
+            // you may have noticed that we need to resort to clunky implementations for async operations
+            // (they are in extractValueFromTaskWithoutMainThreadAwait)
+            // so for now we will just take the folder path and access the files that way
+            const auto path = buildPath(foundFolder.Path(), FragmentsSubDirectory);
+
+            if (std::filesystem::is_directory(path))
+            {
+                findFragmentFiles(path, packageName);
+            }
         }
+    }
 
-        // Likewise, getting the public folder from an extension is an async operation.
-        auto foundFolder = extractValueFromTaskWithoutMainThreadAwait(ext.GetPublicFolderAsync());
-        if (!foundFolder)
+    forEachConcurrently(fragmentFiles.size(), [&](const size_t i) {
+        auto& fragment = til::at(fragmentFiles, i);
+        try
         {
-            continue;
+            const auto content = til::io::read_file_as_utf8_string_if_exists(fragment.path);
+            if (!content.empty())
+            {
+                fragment.json.emplace(_parseJson(content));
+            }
         }
+        CATCH_LOG();
+    });
 
-        // the StorageFolder class has its own methods for obtaining the files within the folder
-        // however, all those methods are Async methods
-        // you may have noticed that we need to resort to clunky implementations for async operations
-        // (they are in extractValueFromTaskWithoutMainThreadAwait)
-        // so for now we will just take the folder path and access the files that way
-        const auto path = buildPath(foundFolder.Path(), FragmentsSubDirectory);
+    ParsedSettings fragmentSettings;
 
-        if (std::filesystem::is_directory(path))
+    for (auto& fragment : fragmentFiles)
+    {
+        if (fragment.json)
         {
-            parseAndLayerFragmentFiles(path, packageName);
+            try
+            {
+                _parseFragment(fragment.source, std::move(*fragment.json), fragmentSettings);
+            }
+            CATCH_LOG();
         }
     }
 }
@@ -626,8 +689,19 @@ std::span<const winrt::com_ptr<Profile>> SettingsLoader::_getNonUserOriginProfil
 // This function is to be used for user settings files.
 void SettingsLoader::_parse(const OriginTag origin, const winrt::hstring& source, const std::string_view& content, ParsedSettings& settings)
 {
-    const auto json = _parseJson(content);
+    if (origin == OriginTag::InBox)
+    {
+        _parse(origin, source, *_parseInboxJson(content), settings);
+    }
+    else
+    {
+        _parse(origin, source, _parseJson(content), settings);
+    }
+}
 
+// Same as above, but for settings that have already been parsed by _parseJson().
+void SettingsLoader::_parse(const OriginTag origin, const winrt::hstring& source, const JsonSettings& json, ParsedSettings& settings)
+{
     settings.clear();
 
     {
@@ -699,8 +773,12 @@ void SettingsLoader::_parse(const OriginTag origin, const winrt::hstring& source
 // schemes and profiles. Additionally this function supports profiles which specify an "updates" key.
 void SettingsLoader::_parseFragment(const winrt::hstring& source, const std::string_view& content, ParsedSettings& settings)
 {
-    auto json = _parseJson(content);
+    _parseFragment(source, _parseJson(content), settings);
+}
 
+// Same as above, but for fragments that have already been parsed by _parseJson().
+void SettingsLoader::_parseFragment(const winrt::hstring& source, JsonSettings&& json, ParsedSettings& settings)
+{
     settings.clear();
 
     {
@@ -792,6 +870,29 @@ SettingsLoader::JsonSettings SettingsLoader::_parseJson(const std::string_view&
     return JsonSettings{ std::move(root), colorSchemes, profileDefaults, profilesList, themes };
 }
 
+// The inbox settings are compiled into the binary, so they're identical for every settings
+// (re)load during the lifetime of the process. This caches the result of parsing them.
+// The cache is validated by a hash of the content, because tests pass custom inbox settings.
+std::shared_ptr<const SettingsLoader::JsonSettings> SettingsLoader::_parseInboxJson(const std::string_view& content)
+{
+    static std::mutex mutex;
+    static std::shared_ptr<const JsonSettings> cached;
+    static size_t cachedHash = 0;
+    static size_t cachedSize = 0;
+
+    const auto hash = til::hash(content);
+    const std::lock_guard lock{ mutex };
+
+    if (!cached || cachedHash != hash || cachedSize != content.size())
+    {
+        cached = std::make_shared<const JsonSettings>(_parseJson(content));
+        cachedHash = hash;
+        cachedSize = content.size();
+    }
+
+    return cached;
+}
+
 // Just a common helper function between _parse and _parseFragment.
 // Parses a profile and ensures it has a Guid if possible.
 winrt::com_ptr<Profile> SettingsLoader::_parseProfile(const OriginTag origin, const winrt::hstring& source, const Json::Value& profileJson)
@@ -909,34 +1010,56 @@ void SettingsLoader::_addOrMergeUserColorScheme(const winrt::com_ptr<implementat
     }
 }
 
-// As the name implies it executes a generator.
-// Generated profiles are added to .inboxSettings. Used by GenerateProfiles().
-void SettingsLoader::_executeGenerator(const IDynamicProfileGenerator& generator)
+// As the name implies it executes the given generators. They run concurrently, because many of them
+// are slow (they spawn processes, query COM servers or scan the disk), but their profiles are added to
+// .inboxSettings in the order of the given list, independent of which generator finished first.
+// Used by GenerateProfiles().
+void SettingsLoader::_executeGenerators(std::span<const IDynamicProfileGenerator* const> generators)
 {
-    const auto generatorNamespace = generator.GetNamespace();
-    if (_ignoredNamespaces.count(generatorNamespace))
-    {
-        return;
-    }
+    std::vector<std::vector<winrt::com_ptr<implementation::Profile>>> results(generators.size());
 
-    const auto previousSize = inboxSettings.profiles.size();
+    forEachConcurrently(generators.size(), [&](const size_t i) {
+        const auto& generator = *til::at(generators, i);
+        const auto generatorNamespace = generator.GetNamespace();
+        if (_ignoredNamespaces.count(generatorNamespace))
+        {
+            return;
+        }
 
-    try
-    {
-        generator.GenerateProfiles(inboxSettings.profiles);
-    }
-    CATCH_LOG_MSG("Dynamic Profile Namespace: \"%.*s\"", gsl::narrow<int>(generatorNamespace.size()), generatorNamespace.data())
+        // Some generators (like the VisualStudioGenerator) use COM. Thread pool threads
+        // may not have joined an apartment yet, so we make sure they have.
+        const auto hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        const auto uninit = wil::scope_exit([&]() {
+            if (SUCCEEDED(hr))
+            {
+                CoUninitialize();
+            }
+        });
+
+        try
+        {
+            generator.GenerateProfiles(til::at(results, i));
+        }
+        CATCH_LOG_MSG("Dynamic Profile Namespace: \"%.*s\"", gsl::narrow<int>(generatorNamespace.size()), generatorNamespace.data())
+    });
 
-    // If the generator produced some profiles we're going to give them default attributes.
-    // By setting the Origin/Source/etc. here, we deduplicate some code and ensure they aren't missing accidentally.
-    if (inboxSettings.profiles.size() > previousSize)
+    for (size_t i = 0; i < generators.size(); ++i)
     {
-        const winrt::hstring source{ generatorNamespace };
+        auto& profiles = til::at(results, i);
+        if (profiles.empty())
+        {
+            continue;
+        }
+
+        // If the generator produced some profiles we're going to give them default attributes.
+        // By setting the Origin/Source/etc. here, we deduplicate some code and ensure they aren't missing accidentally.
+        const winrt::hstring source{ til::at(generators, i)->GetNamespace() };
 
-        for (const auto& profile : std::span(inboxSettings.profiles).subspan(previousSize))
+        for (auto& profile : profiles)
         {
             profile->Origin(OriginTag::Generated);
             profile->Source(source);
+            inboxSettings.profiles.emplace_back(std::move(profile));
         }
     }
 }
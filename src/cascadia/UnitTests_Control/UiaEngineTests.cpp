@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "../../renderer/uia/UiaRenderer.hpp"
+
+using namespace Microsoft::Console::Render;
+using namespace Microsoft::Console::Types;
+using namespace WEX::Logging;
+
+namespace ControlUnitTests
+{
+    class UiaEngineTests
+    {
+        BEGIN_TEST_CLASS(UiaEngineTests)
+            TEST_CLASS_PROPERTY(L"TestTimeout", L"0:0:10") // 10s timeout
+        END_TEST_CLASS()
+
+        TEST_METHOD(NewTextOverflow);
+
+        // Records the text that the engine hands to automation clients.
+        struct MockDispatcher final : IUiaEventDispatcher
+        {
+            void SignalSelectionChanged() override {}
+            void SignalTextChanged() override {}
+            void SignalCursorChanged() override {}
+            void NotifyNewOutput(std::wstring_view newOutput) override
+            {
+                output.append(newOutput);
+            }
+
+            std::wstring output;
+        };
+
+        static void _paintFrame(UiaEngine& engine)
+        {
+            VERIFY_ARE_EQUAL(S_OK, engine.StartPaint());
+            VERIFY_ARE_EQUAL(S_OK, engine.EndPaint());
+            VERIFY_ARE_EQUAL(S_OK, engine.Present());
+        }
+    };
+
+    void UiaEngineTests::NewTextOverflow()
+    {
+        MockDispatcher dispatcher;
+        UiaEngine engine{ &dispatcher };
+
+        // The interval is long enough that the second frame below is always rate limited, no matter how slow the machine is.
+        static constexpr size_t limit = 10000;
+        engine.SetNewTextLimits(limit, std::chrono::minutes{ 10 });
+
+        static constexpr size_t lineLength = 4000;
+        const std::wstring a(lineLength, L'a');
+        const std::wstring b(lineLength, L'b');
+        const std::wstring c(lineLength, L'c');
+
+        Log::Comment(L"Write 3 lines (each followed by a newline) which together exceed the ring buffer.");
+        VERIFY_ARE_EQUAL(S_OK, engine.NotifyNewText(a));
+        VERIFY_ARE_EQUAL(S_OK, engine.NotifyNewText(b));
+        VERIFY_ARE_EQUAL(S_OK, engine.NotifyNewText(c));
+
+        const auto written = 3 * (lineLength + 1);
+        VERIFY_IS_GREATER_THAN(written, limit);
+        VERIFY_ARE_EQUAL(written - limit, engine.GetDroppedNewTextCount());
+
+        Log::Comment(L"Only the most recent output is flushed, without the partial line at its start.");
+        _paintFrame(engine);
+        VERIFY_ARE_EQUAL(b + L"\n" + c + L"\n", dispatcher.output);
+        VERIFY_IS_FALSE(engine.RequiresContinuousRedraw());
+
+        Log::Comment(L"Output that follows within the interval is held back until a later frame.");
+        dispatcher.output.clear();
+        VERIFY_ARE_EQUAL(S_OK, engine.NotifyNewText(L"d"));
+        _paintFrame(engine);
+        VERIFY_ARE_EQUAL(L"", dispatcher.output);
+        VERIFY_IS_TRUE(engine.RequiresContinuousRedraw());
+        VERIFY_ARE_EQUAL(written - limit, engine.GetDroppedNewTextCount());
+    }
+}
@@ -52,6 +52,7 @@ class TerminalCoreUnitTests::TerminalBufferTests final
     TEST_METHOD(TestGetReverseTab);
 
     TEST_METHOD(TestURLPatternDetection);
+    TEST_METHOD(TestURLPatternDetectionAfterChange);
 
     TEST_METHOD_SETUP(MethodSetup)
     {
@@ -634,3 +635,33 @@ void TerminalBufferTests::TestURLPatternDetection()
     result = term->GetHyperlinkAtBufferPosition(til::point{ urlEndX + 1, 0 });
     VERIFY_IS_TRUE(result.empty(), L"URL is not detected after the actual URL.");
 }
+
+void TerminalBufferTests::TestURLPatternDetectionAfterChange()
+{
+    using namespace std::string_view_literals;
+
+    constexpr auto UrlStr = L"https://www.contoso.com"sv;
+
+    auto originalDetectURLs = term->_detectURLs;
+    auto restoreDetectUrls = wil::scope_exit([&]() {
+        term->_detectURLs = originalDetectURLs;
+    });
+    term->_detectURLs = true;
+
+    auto& termSm = *term->_stateMachine;
+    termSm.ProcessString(UrlStr);
+    term->UpdatePatternsUnderLock();
+    VERIFY_ARE_EQUAL(term->GetHyperlinkAtBufferPosition(til::point{ 0, 0 }), UrlStr);
+
+    // The per-line pattern cache must not return stale matches for a row whose contents changed.
+    termSm.ProcessString(L"\r\x1b[K"sv);
+    term->UpdatePatternsUnderLock();
+    VERIFY_IS_TRUE(term->GetHyperlinkAtBufferPosition(til::point{ 0, 0 }).empty());
+
+    // But it should find the very same URL again once it moved to another row.
+    termSm.ProcessString(L"\r\n"sv);
+    termSm.ProcessString(UrlStr);
+    term->UpdatePatternsUnderLock();
+    VERIFY_IS_TRUE(term->GetHyperlinkAtBufferPosition(til::point{ 0, 0 }).empty());
+    VERIFY_ARE_EQUAL(term->GetHyperlinkAtBufferPosition(til::point{ 0, 1 }), UrlStr);
+}
@@ -728,13 +728,21 @@ void VtIo::Writer::WriteAttributes(const TextAttribute& attributes) const
 }
 
 void VtIo::Writer::WriteInfos(til::point target, std::span<const CHAR_INFO> infos) const
+{
+    WORD attributes = 0xffff;
+    WriteCUP(target);
+    WriteInfosAtCursor(infos, attributes);
+}
+
+// Same as WriteInfos(), but writes the infos at the current cursor position.
+// `attributes` holds the legacy attributes the terminal currently uses (or 0xffff if unknown)
+// and will be updated to the attributes of the last written cell. This allows callers that write
+// multiple spans in a row to avoid repeating the same SGR sequence for each of them.
+void VtIo::Writer::WriteInfosAtCursor(std::span<const CHAR_INFO> infos, WORD& attributes) const
 {
     const auto beg = infos.begin();
     const auto end = infos.end();
     const auto last = end - 1;
-    WORD attributes = 0xffff;
-
-    WriteCUP(target);
 
     for (auto it = beg; it != end; ++it)
     {
@@ -26,6 +26,9 @@ using namespace Microsoft::Console::Types;
 using namespace Microsoft::Console::VirtualTerminal;
 using Microsoft::Console::Interactivity::ServiceLocator;
 
+// The conversion buffer WriteConsoleAImpl reuses between calls is freed once it exceeds this many characters.
+static constexpr size_t s_writeConsoleABufferRetainLimit = 1024 * 1024;
+
 constexpr bool controlCharPredicate(wchar_t wch)
 {
     return wch < L' ' || wch == 0x007F;
@@ -526,9 +529,19 @@ NT_CATCH_RETURN()
         const auto codepage{ consoleInfo.OutputCP };
         auto leadByteCaptured{ false };
         auto leadByteConsumed{ false };
-        std::wstring wstr{};
         static til::u8state u8State{};
 
+        // This is the hottest path for UTF-8 clients. We hold the console lock, so instead of
+        // allocating a fresh UTF-16 buffer for every call we reuse one and only hold onto
+        // its memory if it stays reasonably small. (WriteData copies the string if it needs to wait.)
+        static std::wstring wstr{};
+        const auto releaseBuffer = wil::scope_exit([&]() noexcept {
+            if (wstr.capacity() > s_writeConsoleABufferRetainLimit)
+            {
+                wstr = std::wstring{};
+            }
+        });
+
         // Convert our input parameters to Unicode
         if (codepage == CP_UTF8)
         {
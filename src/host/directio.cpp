@@ -502,11 +502,117 @@ CATCH_RETURN();
     CATCH_RETURN();
 }
 
+// Used by WriteConsoleOutputWImplHelper in differential mode. Classic TUIs tend to call WriteConsoleOutput for the
+// entire screen on every keystroke. Instead of re-emitting the entire row, this compares the incoming cells with
+// the ones in the buffer (which mirrors what the terminal shows) and only emits the spans that actually changed.
+// This must be called before the infos are written into the buffer.
+static void _writeChangedInfos(const Microsoft::Console::VirtualTerminal::VtIo::Writer& writer,
+                               const ROW& row,
+                               const til::point target,
+                               const std::span<const CHAR_INFO> infos,
+                               WORD& attributes)
+{
+    // Rewriting a few unchanged cells is cheaper than emitting another CUP, so spans closer than this get merged.
+    static constexpr til::CoordType mergeDistance = 8;
+
+    enum : uint8_t
+    {
+        Changed = 1, // the cell differs from the buffer contents
+        WideLeft = 2, // the cell is the trailing half of a wide glyph, either in the buffer or in the infos
+        WideRight = 4, // the cell is the leading half of a wide glyph, either in the buffer or in the infos
+    };
+
+    const auto width = gsl::narrow_cast<til::CoordType>(infos.size());
+    til::small_vector<uint8_t, 256> cells;
+    cells.resize(infos.size());
+
+    auto attrIt = row.AttrBegin() + target.x;
+    for (til::CoordType i = 0; i < width; ++i, ++attrIt)
+    {
+        const auto& ci = til::at(infos, i);
+        const auto column = target.x + i;
+
+        auto incomingDbcs = DbcsAttribute::Single;
+        if (WI_IsFlagSet(ci.Attributes, COMMON_LVB_LEADING_BYTE))
+        {
+            incomingDbcs = DbcsAttribute::Leading;
+        }
+        else if (WI_IsFlagSet(ci.Attributes, COMMON_LVB_TRAILING_BYTE))
+        {
+            incomingDbcs = DbcsAttribute::Trailing;
+        }
+
+        const auto existingDbcs = row.DbcsAttrAt(column);
+        const auto glyph = row.GlyphAt(column);
+        uint8_t flags = 0;
+
+        if (existingDbcs == DbcsAttribute::Trailing || incomingDbcs == DbcsAttribute::Trailing)
+        {
+            flags |= WideLeft;
+        }
+        if (existingDbcs == DbcsAttribute::Leading || incomingDbcs == DbcsAttribute::Leading)
+        {
+            flags |= WideRight;
+        }
+        if (existingDbcs != incomingDbcs ||
+            glyph.size() != 1 ||
+            glyph.front() != ci.Char.UnicodeChar ||
+            *attrIt != TextAttribute{ ci.Attributes })
+        {
+            flags |= Changed;
+        }
+
+        til::at(cells, i) = flags;
+    }
+
+    til::CoordType previousEnd = 0;
+    for (til::CoordType x = 0; x < width;)
+    {
+        if (!(til::at(cells, x) & Changed))
+        {
+            x++;
+            continue;
+        }
+
+        auto spanBeg = x;
+        auto spanEnd = x + 1;
+        for (auto probe = spanEnd; probe < width && probe - spanEnd < mergeDistance; ++probe)
+        {
+            if (til::at(cells, probe) & Changed)
+            {
+                spanEnd = probe + 1;
+            }
+        }
+
+        // Don't cut any wide glyphs in half, neither the ones in the buffer nor the incoming ones.
+        while (spanBeg > previousEnd && (til::at(cells, spanBeg) & WideLeft))
+        {
+            spanBeg--;
+        }
+        while (spanEnd < width && (til::at(cells, spanEnd - 1) & WideRight))
+        {
+            spanEnd++;
+        }
+
+        // The cursor only needs to be saved if we end up emitting anything at all.
+        writer.BackupCursor();
+        writer.WriteCUP({ target.x + spanBeg, target.y });
+        writer.WriteInfosAtCursor(infos.subspan(spanBeg, gsl::narrow_cast<size_t>(spanEnd - spanBeg)), attributes);
+
+        previousEnd = spanEnd;
+        x = spanEnd;
+    }
+}
+
+// Routine Description:
+// - Writes the given CHAR_INFOs into the requestRectangle of the active buffer and mirrors them to the terminal
+//   if we're in ConPTY mode. In differential mode only the cells that differ from the buffer contents are emitted.
 [[nodiscard]] HRESULT WriteConsoleOutputWImplHelper(SCREEN_INFORMATION& context,
                                                     std::span<const CHAR_INFO> buffer,
                                                     til::CoordType bufferStride,
                                                     const Viewport& requestRectangle,
-                                                    Viewport& writtenRectangle) noexcept
+                                                    Viewport& writtenRectangle,
+                                                    const bool differential) noexcept
 {
     try
     {
@@ -541,20 +647,29 @@ CATCH_RETURN();
 
         auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         auto writer = gci.GetVtWriterForBuffer(&context);
+        // The SGR state of the terminal during differential writes. 0xffff means "unknown".
+        WORD writerAttributes = 0xffff;
 
         for (til::CoordType y = clippedRectangle.Top(); y <= clippedRectangle.BottomInclusive(); y++)
         {
             const auto charInfos = buffer.subspan(totalOffset, width);
             const til::point target{ clippedRectangle.Left(), y };
 
-            // Make the iterator and write to the target position.
-            storageBuffer.Write(OutputCellIterator(charInfos), target);
-
             if (writer)
             {
-                writer.WriteInfos(target, charInfos);
+                if (differential)
+                {
+                    _writeChangedInfos(writer, storageBuffer.GetTextBuffer().GetRowByOffset(y), target, charInfos, writerAttributes);
+                }
+                else
+                {
+                    writer.WriteInfos(target, charInfos);
+                }
             }
 
+            // Make the iterator and write to the target position.
+            storageBuffer.Write(OutputCellIterator(charInfos), target);
+
             totalOffset += bufferStride;
         }
 
@@ -587,15 +702,11 @@ CATCH_RETURN();
         auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         auto writer = gci.GetVtWriterForBuffer(&context);
 
-        if (writer)
-        {
-            writer.BackupCursor();
-        }
-
         const auto codepage = gci.OutputCP;
         LOG_IF_FAILED(_ConvertCellsToWInplace(codepage, buffer, requestRectangle));
 
-        RETURN_IF_FAILED(WriteConsoleOutputWImplHelper(context, buffer, requestRectangle.Width(), requestRectangle, writtenRectangle));
+        // The differential mode backs up the cursor itself, once it has anything to write.
+        RETURN_IF_FAILED(WriteConsoleOutputWImplHelper(context, buffer, requestRectangle.Width(), requestRectangle, writtenRectangle, true));
 
         if (writer)
         {
@@ -620,12 +731,8 @@ CATCH_RETURN();
         auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         auto writer = gci.GetVtWriterForBuffer(&context);
 
-        if (writer)
-        {
-            writer.BackupCursor();
-        }
-
-        RETURN_IF_FAILED(WriteConsoleOutputWImplHelper(context, buffer, requestRectangle.Width(), requestRectangle, writtenRectangle));
+        // The differential mode backs up the cursor itself, once it has anything to write.
+        RETURN_IF_FAILED(WriteConsoleOutputWImplHelper(context, buffer, requestRectangle.Width(), requestRectangle, writtenRectangle, true));
 
         if (writer)
         {
@@ -108,7 +108,7 @@ void CommandHistory::_Reset()
         {
             std::wstring reuse{};
 
-            if (suppressDuplicates)
+            if (suppressDuplicates && _MightContain(newCommand))
             {
                 Index index;
                 if (FindMatchingCommand(newCommand, LastDisplayed, index, CommandHistory::MatchOptions::ExactMatch))
@@ -120,7 +120,8 @@ void CommandHistory::_Reset()
             // find free record.  if all records are used, free the lru one.
             if (GetNumberOfCommands() == _maxCommands)
             {
-                _commands.erase(_commands.cbegin());
+                _UntrackCommand(_commands.front());
+                _commands.pop_front();
                 // move LastDisplayed back one in order to stay synced with the
                 // command it referred to before erasing the lru one
                 --LastDisplayed;
@@ -129,12 +130,13 @@ void CommandHistory::_Reset()
             // add newCommand to array
             if (!reuse.empty())
             {
-                _commands.emplace_back(reuse);
+                _commands.emplace_back(std::move(reuse));
             }
             else
             {
                 _commands.emplace_back(newCommand);
             }
+            _TrackCommand(newCommand);
 
             if (LastDisplayed == -1 ||
                 _commands.at(LastDisplayed).size() != newCommand.size() ||
@@ -162,7 +164,7 @@ std::wstring_view CommandHistory::GetNth(Index index) const
     return {};
 }
 
-const std::vector<std::wstring>& CommandHistory::GetCommands() const noexcept
+const std::deque<std::wstring>& CommandHistory::GetCommands() const noexcept
 {
     return _commands;
 }
@@ -211,6 +213,7 @@ std::wstring_view CommandHistory::GetLastCommand() const
 void CommandHistory::Empty()
 {
     _commands.clear();
+    _commandHashes.clear();
     LastDisplayed = -1;
     WI_SetFlag(Flags, CLE_RESET);
 }
@@ -243,7 +246,12 @@ void CommandHistory::Realloc(const Index commands)
         return;
     }
 
-    _commands.resize(std::min(_commands.size(), gsl::narrow_cast<size_t>(std::max(0, commands))));
+    const auto newSize = std::min(_commands.size(), gsl::narrow_cast<size_t>(std::max(0, commands)));
+    for (auto i = newSize; i < _commands.size(); ++i)
+    {
+        _UntrackCommand(_commands[i]);
+    }
+    _commands.resize(newSize);
 
     WI_SetFlag(Flags, CLE_RESET);
     LastDisplayed = GetNumberOfCommands() - 1;
@@ -349,6 +357,7 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
         if (!SameApp)
         {
             BestCandidate->_commands.clear();
+            BestCandidate->_commandHashes.clear();
             BestCandidate->LastDisplayed = -1;
             BestCandidate->_appName = appName;
         }
@@ -412,8 +421,9 @@ std::wstring CommandHistory::Remove(const Index iDel)
         return {};
     }
 
-    const auto str = std::move(_commands.at(iDel));
+    auto str = std::move(_commands.at(iDel));
     _commands.erase(_commands.begin() + iDel);
+    _UntrackCommand(str);
 
     if (LastDisplayed == iDel)
     {
@@ -427,6 +437,28 @@ std::wstring CommandHistory::Remove(const Index iDel)
     return str;
 }
 
+void CommandHistory::_TrackCommand(const std::wstring_view command)
+{
+    ++_commandHashes[std::hash<std::wstring_view>{}(command)];
+}
+
+void CommandHistory::_UntrackCommand(const std::wstring_view command)
+{
+    const auto it = _commandHashes.find(std::hash<std::wstring_view>{}(command));
+    if (it != _commandHashes.end() && --it->second <= 0)
+    {
+        _commandHashes.erase(it);
+    }
+}
+
+// Routine Description:
+// - Returns false if the given command is definitely not stored in this history.
+//   Hash collisions may result in false positives, so a true result needs to be verified.
+bool CommandHistory::_MightContain(const std::wstring_view command) const
+{
+    return _commandHashes.contains(std::hash<std::wstring_view>{}(command));
+}
+
 // Routine Description:
 // - this routine finds the most recent command that starts with the letters already in the current command.  it returns the array index (no mod needed).
 [[nodiscard]] bool CommandHistory::FindMatchingCommand(const std::wstring_view givenCommand,
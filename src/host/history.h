@@ -48,7 +48,7 @@ public:
 
     Index GetNumberOfCommands() const;
     std::wstring_view GetNth(Index index) const;
-    const std::vector<std::wstring>& GetCommands() const noexcept;
+    const std::deque<std::wstring>& GetCommands() const noexcept;
 
     void Realloc(Index commands);
     void Empty();
@@ -73,9 +73,17 @@ private:
     void _Dec(Index& ind) const;
     void _Inc(Index& ind) const;
 
-    // NOTE: In conhost v1 this used to be a circular buffer because removal at the
-    // start is a very common operation. It seems this was lost in the C++ refactor.
-    std::vector<std::wstring> _commands;
+    void _TrackCommand(const std::wstring_view command);
+    void _UntrackCommand(const std::wstring_view command);
+    bool _MightContain(const std::wstring_view command) const;
+
+    // In conhost v1 this used to be a circular buffer because removal at the start is a very
+    // common operation (once the history is full, every Add() evicts the oldest command).
+    // A deque gives us the same: O(1) removal at the front and O(1) random access.
+    std::deque<std::wstring> _commands;
+    // The number of commands in _commands per hash of their text. Add() uses this to skip
+    // the linear search for duplicates if the command definitely isn't in the history yet.
+    std::unordered_map<size_t, Index> _commandHashes;
     Index _maxCommands = 0;
 
     std::wstring _appName;
@@ -535,7 +535,15 @@ void SCREEN_INFORMATION::RefreshFontWithRenderer()
             break;
         }
 
-        CodepointWidthDetector::Singleton().Reset(mode);
+        auto& cwd = CodepointWidthDetector::Singleton();
+        cwd.Reset(mode);
+
+        // Only the console mode asks the renderer about ambiguous widths. Resolve all of them
+        // for the new font now instead of stalling the output of the first text that contains them.
+        if (mode == TextMeasurementMode::Console)
+        {
+            cwd.ResolveAmbiguousWidths();
+        }
     }
 }
 
@@ -242,6 +242,30 @@ class HistoryTests
         VERIFY_ARE_EQUAL(2, history->GetNumberOfCommands());
     }
 
+    TEST_METHOD(AddNoDuplicatesAfterWrapping)
+    {
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+
+        Log::Comment(L"Overfill the history, so that the oldest items get evicted.");
+        for (const auto& item : _manyHistoryItems)
+        {
+            VERIFY_SUCCEEDED(history->Add(item, true));
+        }
+        VERIFY_ARE_EQUAL(s_BufferSize, history->GetNumberOfCommands());
+
+        Log::Comment(L"Evicted items aren't duplicates anymore and get appended...");
+        VERIFY_SUCCEEDED(history->Add(_manyHistoryItems[0], true));
+        VERIFY_ARE_EQUAL(s_BufferSize, history->GetNumberOfCommands());
+        VERIFY_ARE_EQUAL(String(_manyHistoryItems[0].c_str()), String(history->GetNth(s_BufferSize - 1).data()));
+
+        Log::Comment(L"...while stored ones are moved to the end.");
+        VERIFY_SUCCEEDED(history->Add(_manyHistoryItems[5], true));
+        VERIFY_ARE_EQUAL(s_BufferSize, history->GetNumberOfCommands());
+        VERIFY_ARE_EQUAL(String(_manyHistoryItems[5].c_str()), String(history->GetNth(s_BufferSize - 1).data()));
+        VERIFY_ARE_EQUAL(String(_manyHistoryItems[0].c_str()), String(history->GetNth(s_BufferSize - 2).data()));
+    }
+
 private:
     const std::array<std::wstring, 5> _manyApps = {
         L"foo.exe",
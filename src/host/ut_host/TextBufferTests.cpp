@@ -151,6 +151,14 @@ class TextBufferTests
 
     TEST_METHOD(HyperlinkTrim);
     TEST_METHOD(NoHyperlinkTrim);
+    TEST_METHOD(HyperlinkTrimIsDeferred);
+    TEST_METHOD(HyperlinkIdExhaustion);
+    TEST_METHOD(HyperlinkIdReuse);
+    TEST_METHOD(RecycledBufferIsBlank);
+    TEST_METHOD(ResetRestoresDirtyColumns);
+    TEST_METHOD(MeasureRightTracksWrites);
+    TEST_METHOD(RotateRowsInScrollRegion);
+    TEST_METHOD(SerializeResyncRoundTrip);
 
     TEST_METHOD(ReflowPromptRegions);
 };
@@ -2566,6 +2574,15 @@ void TextBufferTests::GetPlainText()
 
         // Verify expected output and actual output are the same
         VERIFY_ARE_EQUAL(expectedText, result);
+
+        // Writing into a caller-provided buffer yields the same text and truncates it if the buffer is too small.
+        std::wstring buffered(expectedText.size(), L'\0');
+        VERIFY_ARE_EQUAL(expectedText.size(), _buffer->GetPlainText(req, buffered));
+        VERIFY_ARE_EQUAL(expectedText, buffered);
+
+        std::wstring truncated(3, L'\0');
+        VERIFY_ARE_EQUAL(expectedText.size(), _buffer->GetPlainText(req, truncated));
+        VERIFY_ARE_EQUAL(expectedText.substr(0, 3), truncated);
     }
     else
     {
@@ -2731,12 +2748,12 @@ void TextBufferTests::HyperlinkTrim()
     const auto finalOtherCustomId = fmt::format(L"{}%{}", otherCustomId, til::hash(otherUrl));
 
     // The hyperlink reference that was only in the first row should be deleted from the map
-    VERIFY_ARE_EQUAL(_buffer->_hyperlinkMap.find(id), _buffer->_hyperlinkMap.end());
+    VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(id), L"");
     // Since there was a custom id, that should be deleted as well
     VERIFY_ARE_EQUAL(_buffer->_hyperlinkCustomIdMap.find(finalCustomId), _buffer->_hyperlinkCustomIdMap.end());
 
     // The other hyperlink reference should not be deleted
-    VERIFY_ARE_EQUAL(_buffer->_hyperlinkMap[otherId], otherUrl);
+    VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(otherId), otherUrl);
     VERIFY_ARE_EQUAL(_buffer->_hyperlinkCustomIdMap[finalOtherCustomId], otherId);
 }
 
@@ -2775,6 +2792,399 @@ void TextBufferTests::NoHyperlinkTrim()
     VERIFY_ARE_EQUAL(_buffer->_hyperlinkCustomIdMap[finalCustomId], id);
 }
 
+// This tests that obsolete hyperlink references are only removed once enough of them have piled up
+// relative to the buffer height, and that the sweep then only removes the unreferenced ones.
+void TextBufferTests::HyperlinkTrimIsDeferred()
+{
+    // 4 recycled links are needed before a buffer of this height gets swept.
+    const til::size bufferSize{ 80, 64 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, false, &_renderer);
+
+    static constexpr std::array<std::wstring_view, 4> urls{ L"a.url", L"b.url", L"c.url", L"d.url" };
+    std::array<uint16_t, 4> ids{};
+
+    // Put a unique hyperlink into each of the first 4 rows. The last one is also referenced further down.
+    for (til::CoordType y = 0; y < 4; ++y)
+    {
+        const auto& url = til::at(urls, y);
+        auto& id = til::at(ids, y);
+        id = _buffer->GetHyperlinkId(url, {});
+        TextAttribute newAttr{ 0x7f };
+        newAttr.SetHyperlinkId(id);
+        _buffer->GetMutableRowByOffset(y).SetAttrToEnd(70, newAttr);
+        _buffer->AddHyperlinkToMap(url, id);
+
+        if (y == 3)
+        {
+            _buffer->GetMutableRowByOffset(40).SetAttrToEnd(70, newAttr);
+        }
+    }
+
+    // Recycling the first 3 rows only collects their links as candidates. They must remain resolvable.
+    for (auto i = 0; i < 3; ++i)
+    {
+        _buffer->IncrementCircularBuffer();
+        for (size_t j = 0; j < ids.size(); ++j)
+        {
+            VERIFY_ARE_EQUAL(til::at(urls, j), _buffer->GetHyperlinkUriFromId(til::at(ids, j)));
+        }
+    }
+
+    // The 4th recycled link triggers the sweep, which frees the 3 links that are gone from the buffer...
+    _buffer->IncrementCircularBuffer();
+    for (size_t j = 0; j < 3; ++j)
+    {
+        VERIFY_ARE_EQUAL(L"", _buffer->GetHyperlinkUriFromId(til::at(ids, j)));
+    }
+    // ...but not the one that's still referenced by another row.
+    VERIFY_ARE_EQUAL(til::at(urls, 3), _buffer->GetHyperlinkUriFromId(til::at(ids, 3)));
+}
+
+// This tests that running out of hyperlink ids recycles the ones that are no longer
+// referenced by the buffer without ever handing out an id that's still in use.
+void TextBufferTests::HyperlinkIdExhaustion()
+{
+    const til::size bufferSize{ 80, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, false, &_renderer);
+
+    static constexpr std::wstring_view url{ L"test.url" };
+
+    // Put a single hyperlink into the buffer...
+    const auto liveId = _buffer->GetHyperlinkId(url, {});
+    TextAttribute newAttr{ 0x7f };
+    newAttr.SetHyperlinkId(liveId);
+    _buffer->GetMutableRowByOffset(3).SetAttrToEnd(0, newAttr);
+    _buffer->AddHyperlinkToMap(url, liveId);
+
+    // ...and one that's only held by the DECSC saved attributes...
+    const auto savedId = _buffer->GetHyperlinkId(url, {});
+    TextAttribute savedAttr{ 0x7f };
+    savedAttr.SetHyperlinkId(savedId);
+    _buffer->SetSavedAttributes(savedAttr);
+    _buffer->AddHyperlinkToMap(url, savedId);
+
+    // ...and exhaust the remaining ids with ones that never make it into the buffer.
+    for (auto i = 2; i < std::numeric_limits<uint16_t>::max(); ++i)
+    {
+        const auto id = _buffer->GetHyperlinkId(url, {});
+        VERIFY_ARE_NOT_EQUAL(0u, id);
+        _buffer->AddHyperlinkToMap(url, id);
+    }
+
+    // The URI should have been interned only once.
+    VERIFY_ARE_EQUAL(1u, _buffer->_hyperlinkUris.size());
+
+    const auto recycledId = _buffer->GetHyperlinkId(url, {});
+    VERIFY_ARE_NOT_EQUAL(0u, recycledId);
+    VERIFY_ARE_NOT_EQUAL(liveId, recycledId);
+    VERIFY_ARE_NOT_EQUAL(savedId, recycledId);
+    VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(liveId), url);
+    VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(savedId), url);
+}
+
+// This tests that freed hyperlink ids are reused after a quarantine period,
+// instead of growing the hyperlink table to the full 16-bit id space.
+void TextBufferTests::HyperlinkIdReuse()
+{
+    const til::size bufferSize{ 80, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, false, &_renderer);
+
+    static constexpr std::wstring_view url{ L"test.url" };
+    std::vector<uint16_t> freed;
+
+    for (size_t i = 0; i < 4 * TextBuffer::hyperlinkQuarantine; ++i)
+    {
+        const auto id = _buffer->GetHyperlinkId(url, {});
+        VERIFY_ARE_NOT_EQUAL(0u, id);
+
+        // An id must not be handed out again until hyperlinkQuarantine other ids have been freed after it.
+        const auto it = std::find(freed.begin(), freed.end(), id);
+        if (it != freed.end())
+        {
+            VERIFY_IS_GREATER_THAN_OR_EQUAL(static_cast<size_t>(freed.end() - it), TextBuffer::hyperlinkQuarantine);
+        }
+
+        _buffer->AddHyperlinkToMap(url, id);
+        _buffer->RemoveHyperlinkFromMap(id);
+        freed.emplace_back(id);
+    }
+
+    // The table holds slot 0 and the quarantined ids, plus the one that was reused last.
+    VERIFY_IS_LESS_THAN_OR_EQUAL(_buffer->_hyperlinks.size(), TextBuffer::hyperlinkQuarantine + 2);
+}
+
+void TextBufferTests::RecycledBufferIsBlank()
+{
+    // An unusual size, so that we don't pick up an arena released by another test.
+    const til::size bufferSize{ 37, 11 };
+    const TextAttribute attr{ 0x7f };
+    const TextAttribute dirtyAttr{ 0x1e };
+    std::byte* arena = nullptr;
+
+    {
+        TextBuffer buffer{ bufferSize, attr, 0, false, &_renderer };
+        for (auto y = 0; y < bufferSize.height; ++y)
+        {
+            auto& row = buffer.GetMutableRowByOffset(y);
+            row.ReplaceCharacters(0, 2, L"\x754c");
+            row.SetAttrToEnd(0, dirtyAttr);
+            row.SetWrapForced(true);
+        }
+        arena = buffer._buffer.data();
+    }
+
+    // The new buffer should get the arena of the previous one, but none of its contents.
+    TextBuffer buffer{ bufferSize, attr, 0, false, &_renderer };
+    VERIFY_ARE_EQUAL(arena, buffer._buffer.data());
+
+    const std::wstring blank(bufferSize.width, L' ');
+    for (auto y = 0; y < bufferSize.height; ++y)
+    {
+        const auto& row = buffer.GetRowByOffset(y);
+        VERIFY_ARE_EQUAL(std::wstring_view{ blank }, row.GetText());
+        VERIFY_ARE_EQUAL(attr, row.GetAttrByColumn(0));
+        VERIFY_IS_FALSE(row.WasWrapForced());
+    }
+}
+
+void TextBufferTests::ResetRestoresDirtyColumns()
+{
+    const til::size bufferSize{ 20, 3 };
+    const TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ bufferSize, attr, 0, false, &_renderer };
+    auto& row = buffer.GetMutableRowByOffset(0);
+    const std::wstring blank(bufferSize.width, L' ');
+
+    const auto verifyBlank = [&]() {
+        VERIFY_ARE_EQUAL(std::wstring_view{ blank }, row.GetText());
+        VERIFY_ARE_EQUAL(0, row.MeasureRight());
+        for (til::CoordType x = 0; x < bufferSize.width; ++x)
+        {
+            VERIFY_ARE_EQUAL(x + 1, row.NavigateToNext(x));
+        }
+    };
+
+    // Short ASCII, which only dirties a few leading columns.
+    row.ReplaceCharacters(0, 1, L"y");
+    row.ReplaceCharacters(4, 1, L"z");
+    row.Reset(attr);
+    verifyBlank();
+
+    // A wide glyph in the last column changes the char count and shifts the past-the-end offset.
+    row.ReplaceCharacters(18, 2, L"\x754c");
+    row.Reset(attr);
+    verifyBlank();
+
+    // A surrogate pair needs more chars than columns and moves the text onto the heap.
+    row.ReplaceCharacters(2, 2, L"\xD83D\xDE00");
+    row.ReplaceCharacters(0, 1, L"a");
+    row.Reset(attr);
+    verifyBlank();
+
+    // Writing after a partial reset must not pick up stale offsets.
+    row.ReplaceCharacters(1, 1, L"b");
+    VERIFY_ARE_EQUAL(L" b", row.GetText().substr(0, 2));
+    VERIFY_ARE_EQUAL(2, row.MeasureRight());
+}
+
+void TextBufferTests::MeasureRightTracksWrites()
+{
+    const til::size bufferSize{ 20, 3 };
+    const TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ bufferSize, attr, 0, false, &_renderer };
+    auto& row = buffer.GetMutableRowByOffset(0);
+
+    VERIFY_IS_FALSE(row.ContainsText());
+    VERIFY_ARE_EQUAL(0, row.MeasureRight());
+
+    row.ReplaceCharacters(0, 1, L"a");
+    row.ReplaceCharacters(1, 1, L"b");
+    row.ReplaceCharacters(2, 1, L"c");
+    VERIFY_IS_TRUE(row.ContainsText());
+    VERIFY_ARE_EQUAL(3, row.MeasureRight());
+
+    Log::Comment(L"Text past the previous extent extends it.");
+    row.ReplaceCharacters(10, 1, L"x");
+    VERIFY_ARE_EQUAL(11, row.MeasureRight());
+
+    Log::Comment(L"Erasing the last text falls back to the preceding text.");
+    row.ClearCell(10);
+    VERIFY_ARE_EQUAL(3, row.MeasureRight());
+
+    Log::Comment(L"Erasing text before the extent doesn't change it.");
+    row.ClearCell(0);
+    VERIFY_ARE_EQUAL(3, row.MeasureRight());
+
+    Log::Comment(L"Wide glyphs, and narrow ones overwriting half of them.");
+    row.ReplaceCharacters(18, 2, L"\x754c");
+    VERIFY_ARE_EQUAL(20, row.MeasureRight());
+    row.ReplaceCharacters(19, 1, L"q");
+    VERIFY_ARE_EQUAL(20, row.MeasureRight());
+    row.ClearCell(19);
+    VERIFY_ARE_EQUAL(3, row.MeasureRight());
+
+    Log::Comment(L"Text past the readable columns of a double-width row is ignored.");
+    row.ReplaceCharacters(15, 1, L"y");
+    row.SetLineRendition(LineRendition::DoubleWidth);
+    VERIFY_ARE_EQUAL(3, row.GetLastNonSpaceColumn());
+    row.SetLineRendition(LineRendition::SingleWidth);
+    VERIFY_ARE_EQUAL(16, row.GetLastNonSpaceColumn());
+
+    row.Reset(attr);
+    VERIFY_IS_FALSE(row.ContainsText());
+    VERIFY_ARE_EQUAL(0, row.MeasureRight());
+}
+
+void TextBufferTests::RotateRowsInScrollRegion()
+{
+    const til::size bufferSize{ 4, 8 };
+    const TextAttribute attr{ 0x7f };
+    const TextAttribute fillAttr{ 0x1e };
+    TextBuffer buffer{ bufferSize, attr, 0, false, &_renderer };
+
+    // Every row gets a prompt mark and the wrap flag, both of which must move along with the row.
+    const auto fill = [&]() {
+        for (til::CoordType y = 0; y < bufferSize.height; ++y)
+        {
+            const auto ch = gsl::narrow_cast<wchar_t>(L'0' + y);
+            auto& row = buffer.GetMutableRowByOffset(y);
+            row.ReplaceCharacters(0, 1, { &ch, 1 });
+            row.SetWrapForced(true);
+            row.SetScrollbarData(ScrollbarData{ MarkCategory::Prompt });
+        }
+    };
+    // A space marks a vacated row, which must be blank, filled with fillAttr and have neither mark nor wrap flag.
+    const auto verify = [&](const std::wstring_view expected) {
+        for (til::CoordType y = 0; y < bufferSize.height; ++y)
+        {
+            const auto& row = buffer.GetRowByOffset(y);
+            const auto vacated = expected[y] == L' ';
+            VERIFY_ARE_EQUAL(expected[y], row.GetText()[0]);
+            VERIFY_ARE_EQUAL(vacated ? fillAttr : attr, row.GetAttrByColumn(0));
+            VERIFY_ARE_EQUAL(!vacated, row.WasWrapForced());
+            VERIFY_ARE_EQUAL(!vacated, row.GetScrollbarData().has_value());
+        }
+    };
+
+    // Scroll rows 2-5 up by one, like a line feed at the bottom of a DECSTBM margin of 1-5.
+    // The row that got scrolled out (1) must not reappear in the vacated row (5).
+    fill();
+    buffer.RotateRows(2, 4, -1, fillAttr);
+    verify(L"02345 67");
+
+    // Same, but down by two, like a reverse index. Rows 4-5 must not reappear in the vacated rows 2-3.
+    fill();
+    buffer.RotateRows(2, 2, 2, fillAttr);
+    verify(L"01  2367");
+
+    // Except for the vacated rows, the result must be identical to ScrollRows().
+    fill();
+    buffer.ScrollRows(2, 4, -1);
+    const std::wstring_view scrolled{ L"02345567" };
+    for (til::CoordType y = 0; y < bufferSize.height; ++y)
+    {
+        VERIFY_ARE_EQUAL(scrolled[y], buffer.GetRowByOffset(y).GetText()[0]);
+    }
+}
+
+void TextBufferTests::SerializeResyncRoundTrip()
+{
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    auto& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+    const auto& tbi = si.GetTextBuffer();
+    auto& stateMachine = si.GetStateMachine();
+    const auto rows = tbi.TotalRowCount();
+
+    // Serialize a buffer with a few resync points, of which only the earlier ones are followed by enough rows to fill `tbi`.
+    const til::size bufferSize{ tbi.GetSize().Width(), 1000 };
+    VERIFY_IS_GREATER_THAN(bufferSize.height, rows + 2 * TextBuffer::SerializeResyncInterval);
+
+    std::wstring contents;
+    {
+        TextBuffer buffer{ bufferSize, TextAttribute{}, 0, false, &_renderer };
+        for (til::CoordType y = 0; y < bufferSize.height; ++y)
+        {
+            const auto text = fmt::format(L"line {}", y);
+            TextAttribute attr;
+            attr.SetIndexedForeground(gsl::narrow_cast<BYTE>(y % 8));
+            attr.SetIntense(y % 3 == 0);
+
+            auto& row = buffer.GetMutableRowByOffset(y);
+            RowWriteState state{ .text = text };
+            row.ReplaceText(state);
+            row.ReplaceAttributes(0, state.columnEnd, attr);
+        }
+
+        wchar_t directory[MAX_PATH];
+        wchar_t path[MAX_PATH];
+        VERIFY_ARE_NOT_EQUAL(0u, GetTempPathW(ARRAYSIZE(directory), &directory[0]));
+        VERIFY_ARE_NOT_EQUAL(0u, GetTempFileNameW(&directory[0], L"tb", 0, &path[0]));
+        const auto cleanup = wil::scope_exit([&]() { DeleteFileW(&path[0]); });
+        buffer.Serialize(&path[0]);
+
+        const wil::unique_hfile file{ CreateFileW(&path[0], GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        VERIFY_IS_TRUE(file.is_valid());
+        LARGE_INTEGER size;
+        VERIFY_WIN32_BOOL_SUCCEEDED(GetFileSizeEx(file.get(), &size));
+        contents.resize(gsl::narrow<size_t>(size.QuadPart / 2));
+        DWORD read = 0;
+        VERIFY_WIN32_BOOL_SUCCEEDED(ReadFile(file.get(), contents.data(), gsl::narrow<DWORD>(size.QuadPart), &read, nullptr));
+        VERIFY_ARE_EQUAL(size.QuadPart, static_cast<LONGLONG>(read));
+    }
+
+    VERIFY_ARE_EQUAL(L'\uFEFF', contents.front());
+    const auto text = std::wstring_view{ contents }.substr(1);
+
+    Log::Comment(L"A buffer that's larger than the serialized one needs all of it.");
+    const auto everything = TextBuffer::FindSerializeResyncPoint(text, bufferSize.height);
+    VERIFY_IS_TRUE(everything.prologue.empty());
+    VERIFY_ARE_EQUAL(text.size(), everything.remainder.size());
+
+    // 1000 - 768 rows are too few to fill `tbi`, but 1000 - 512 rows are enough.
+    Log::Comment(L"A smaller buffer can skip everything before one of the resync points.");
+    const auto resync = TextBuffer::FindSerializeResyncPoint(text, rows);
+    VERIFY_IS_TRUE(resync.prologue.starts_with(TextBuffer::SerializeResyncSequence));
+    VERIFY_IS_FALSE(resync.prologue.ends_with(L"\n"));
+    VERIFY_IS_TRUE(resync.remainder.starts_with(L"line 512"));
+
+    struct Row
+    {
+        std::wstring text;
+        std::vector<TextAttribute> attrs;
+    };
+    const auto snapshot = [&]() {
+        std::vector<Row> result;
+        for (til::CoordType y = 0; y < rows; ++y)
+        {
+            const auto& row = tbi.GetRowByOffset(y);
+            result.push_back({ std::wstring{ row.GetText() }, { row.AttrBegin(), row.AttrEnd() } });
+        }
+        return result;
+    };
+
+    // Both restores write more lines than `tbi` has rows, which means that its previous contents don't matter.
+    stateMachine.ProcessString(text);
+    const auto expected = snapshot();
+    const auto lastRow = tbi.GetCursor().GetPosition().y - 1;
+    VERIFY_IS_TRUE(tbi.GetRowByOffset(lastRow).GetText().starts_with(fmt::format(L"line {} ", bufferSize.height - 1)));
+
+    stateMachine.ProcessString(resync.prologue);
+    stateMachine.ProcessString(resync.remainder);
+    const auto actual = snapshot();
+
+    for (til::CoordType y = 0; y < rows; ++y)
+    {
+        VERIFY_ARE_EQUAL(std::wstring_view{ expected[y].text }, std::wstring_view{ actual[y].text });
+        VERIFY_IS_TRUE(expected[y].attrs == actual[y].attrs);
+    }
+}
+
 #define FTCS_A L"\x1b]133;A\x1b\\"
 #define FTCS_B L"\x1b]133;B\x1b\\"
 #define FTCS_C L"\x1b]133;C\x1b\\"
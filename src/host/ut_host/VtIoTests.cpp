@@ -275,6 +275,45 @@ class ::Microsoft::Console::VirtualTerminal::VtIoTests
         VERIFY_ARE_EQUAL(expected, actual);
     }
 
+    TEST_METHOD(WriteConsoleOutputWDifferential)
+    {
+        resetContents();
+
+        std::array payload{
+            // clang-format off
+            ci_red('A'), ci_red('B'), ci_blu('a'), ci_blu('b'), ci_red('C'), ci_red('D'), ci_blu('c'), ci_blu('d'),
+            ci_red('E'), ci_red('F'), ci_blu('e'), ci_blu('f'), ci_red('G'), ci_red('H'), ci_blu('g'), ci_blu('h'),
+            ci_blu('i'), ci_blu('j'), ci_red('I'), ci_red('J'), ci_blu('k'), ci_blu('l'), ci_red('K'), ci_red('L'),
+            ci_blu('m'), ci_blu('n'), ci_red('M'), ci_red('N'), ci_blu('o'), ci_blu('p'), ci_red('O'), ci_red('P'),
+            // clang-format on
+        };
+        const auto target = Viewport::FromDimensions({ 0, 0 }, { 8, 4 });
+        Viewport written;
+        std::string_view expected;
+        std::string_view actual;
+
+        // Everything changed. The SGR state carries over from one row to the next.
+        THROW_IF_FAILED(routines.WriteConsoleOutputWImpl(*screenInfo, payload, target, written));
+        expected =
+            decsc() //
+            cup(1, 1) sgr_red("AB") sgr_blu("ab") sgr_red("CD") sgr_blu("cd") //
+            cup(2, 1) sgr_red("EF") sgr_blu("ef") sgr_red("GH") sgr_blu("gh") //
+            cup(3, 1) "ij" sgr_red("IJ") sgr_blu("kl") sgr_red("KL") //
+            cup(4, 1) sgr_blu("mn") sgr_red("MN") sgr_blu("op") sgr_red("OP") //
+            decrc();
+        actual = readOutput();
+        VERIFY_ARE_EQUAL(expected, actual);
+
+        // Nothing changed, which must not write anything (not even a DECSC/DECRC pair).
+        // It's followed up by a write in which a single cell changed, because reading an empty pipe would block.
+        THROW_IF_FAILED(routines.WriteConsoleOutputWImpl(*screenInfo, payload, target, written));
+        payload[11] = ci_blu('X');
+        THROW_IF_FAILED(routines.WriteConsoleOutputWImpl(*screenInfo, payload, target, written));
+        expected = decsc() cup(2, 4) sgr_blu("X") decrc();
+        actual = readOutput();
+        VERIFY_ARE_EQUAL(expected, actual);
+    }
+
     TEST_METHOD(WriteConsoleOutputAttribute)
     {
         setupInitialContents();
@@ -491,6 +491,59 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             _replace_unchecked(start_index, end_index, replacements._runs);
         }
 
+        // Replaces every value v in the range [start_index, end_index) with func(v).
+        // If end_index is larger than size() it's set to size().
+        // start_index must be smaller or equal to end_index.
+        //
+        // This is a lot faster than calling replace() for each index individually,
+        // because func is only invoked once per run, instead of once per index.
+        template<typename F>
+        void transform(size_type start_index, size_type end_index, F&& func)
+        {
+            _check_indices(start_index, end_index);
+
+            if (start_index == end_index)
+            {
+                return;
+            }
+
+            // Fast path: The entire vector is affected and so we can modify the runs in place.
+            // This includes the very common case of a row with just a single run.
+            if (start_index == 0 && end_index == _total_length)
+            {
+                for (auto& run : _runs)
+                {
+                    run.value = func(std::as_const(run.value));
+                }
+                _compact();
+                return;
+            }
+
+            rle_scanner scanner(_runs.begin(), _runs.end());
+            const auto [begin_run, start_run_pos] = scanner.scan(start_index);
+            const auto [end_run, end_run_pos] = scanner.scan(end_index - 1);
+
+            // Fast path: The range lies within a single run.
+            if (begin_run == end_run)
+            {
+                const rle_type replacement{ func(std::as_const(begin_run->value)), gsl::narrow_cast<size_type>(end_index - start_index) };
+                _replace_unchecked(start_index, end_index, { &replacement, 1 });
+                return;
+            }
+
+            // Otherwise we create the transformed slice of runs and replace the range with it.
+            // _replace_unchecked() takes care of merging the slice with the surrounding runs.
+            til::small_vector<rle_type, 16> replacements{ begin_run, end_run + 1 };
+            replacements.back().length = end_run_pos + 1;
+            replacements.front().length -= start_run_pos;
+            for (auto& run : replacements)
+            {
+                run.value = func(std::as_const(run.value));
+            }
+            _compact_runs(replacements);
+            _replace_unchecked(start_index, end_index, replacements);
+        }
+
         // Replaces every instance of old_value in this vector with new_value.
         void replace_values(const value_type& old_value, const value_type& new_value)
         {
@@ -657,14 +710,24 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 
         void _compact()
         {
-            auto it = _runs.begin();
-            const auto end = _runs.end();
+            _compact_runs(_runs);
+        }
 
-            if (it == end)
+        // Joins adjacent runs with equal values.
+        template<typename C>
+        static void _compact_runs(C& runs)
+        {
+            // Vectors with less than 2 runs (like the inline small_rle<..., 1> case) can't be compacted.
+            if (runs.size() < 2)
             {
                 return;
             }
 
+            auto it = runs.begin();
+            const auto end = runs.end();
+
+            // Most of the time there's nothing to compact. The first loop only compares
+            // values without writing anything until it finds the first pair of joinable runs.
             for (auto ref = it; ++it != end; ref = it)
             {
                 if (ref->value == it->value)
@@ -683,7 +746,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                         }
                     }
 
-                    _runs.erase(++ref, end);
+                    runs.erase(++ref, end);
                     return;
                 }
             }
@@ -41,6 +41,16 @@ namespace til
             til::atomic_notify_all(_now_serving);
         }
 
+        // Returns true if another thread is queued up behind the current owner.
+        // This is only meaningful while the caller holds the lock and is meant for
+        // long-running owners, which can then unlock() and lock() again to let the waiter go first.
+        bool has_waiters() const noexcept
+        {
+            const auto next = _next_ticket.load(std::memory_order_relaxed);
+            const auto serving = _now_serving.load(std::memory_order_relaxed);
+            return next - serving > 1;
+        }
+
     private:
         // You may be inclined to add alignas(std::hardware_destructive_interference_size)
         // here to force the two atomics on separate cache lines, but I suggest to carefully
@@ -146,6 +156,11 @@ namespace til
             return is_locked() ? _recursion : 0;
         }
 
+        bool has_waiters() const noexcept
+        {
+            return _lock.has_waiters();
+        }
+
     private:
         ticket_lock _lock;
         std::atomic<uint32_t> _owner = 0;
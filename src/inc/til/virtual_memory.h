@@ -0,0 +1,140 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <system_error>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace til
+{
+    // A range of reserved address space whose pages can be committed and decommitted on demand.
+    // It's VirtualAlloc(MEM_RESERVE/MEM_COMMIT) and VirtualFree(MEM_DECOMMIT/MEM_RELEASE) on Windows
+    // and mmap(PROT_NONE)/mprotect() and madvise(MADV_DONTNEED)/munmap() everywhere else.
+    class virtual_memory
+    {
+    public:
+        virtual_memory() = default;
+
+        static virtual_memory reserve(size_t size)
+        {
+            virtual_memory vm;
+            vm._size = size;
+
+#ifdef _WIN32
+            vm._data = static_cast<std::byte*>(THROW_LAST_ERROR_IF_NULL(VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_READWRITE)));
+#else
+            const auto ptr = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (ptr == MAP_FAILED)
+            {
+                throw std::system_error{ errno, std::generic_category(), "mmap" };
+            }
+            vm._data = static_cast<std::byte*>(ptr);
+#endif
+
+            return vm;
+        }
+
+        virtual_memory(const virtual_memory&) = delete;
+        virtual_memory& operator=(const virtual_memory&) = delete;
+
+        virtual_memory(virtual_memory&& other) noexcept :
+            _data{ std::exchange(other._data, nullptr) },
+            _size{ std::exchange(other._size, 0) }
+        {
+        }
+
+        virtual_memory& operator=(virtual_memory&& other) noexcept
+        {
+            if (this != &other)
+            {
+                _release();
+                _data = std::exchange(other._data, nullptr);
+                _size = std::exchange(other._size, 0);
+            }
+            return *this;
+        }
+
+        ~virtual_memory()
+        {
+            _release();
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return _data != nullptr;
+        }
+
+        std::byte* data() const noexcept
+        {
+            return _data;
+        }
+
+        size_t size() const noexcept
+        {
+            return _size;
+        }
+
+        // Makes the pages overlapping with [offset, offset+size) readable and writable.
+        // The contents of newly committed pages are zeroed.
+        void commit(size_t offset, size_t size) const
+        {
+#ifdef _WIN32
+            THROW_LAST_ERROR_IF_NULL(VirtualAlloc(_data + offset, size, MEM_COMMIT, PAGE_READWRITE));
+#else
+            const auto [beg, len] = _pageAlign(offset, size);
+            if (mprotect(beg, len, PROT_READ | PROT_WRITE) != 0)
+            {
+                throw std::system_error{ errno, std::generic_category(), "mprotect" };
+            }
+#endif
+        }
+
+        // Returns the pages overlapping with [offset, offset+size) to the OS, without releasing the address space.
+        void decommit(size_t offset, size_t size) const noexcept
+        {
+#ifdef _WIN32
+#pragma warning(suppress : 6250) // Calling 'VirtualFree' without the MEM_RELEASE flag might free memory but not address descriptors (VADs).
+            VirtualFree(_data + offset, size, MEM_DECOMMIT);
+#else
+            const auto [beg, len] = _pageAlign(offset, size);
+            madvise(beg, len, MADV_DONTNEED);
+            mprotect(beg, len, PROT_NONE);
+#endif
+        }
+
+    private:
+#ifndef _WIN32
+        std::pair<std::byte*, size_t> _pageAlign(size_t offset, size_t size) const noexcept
+        {
+            static const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+            const auto beg = reinterpret_cast<uintptr_t>(_data + offset) & ~(pageSize - 1);
+            const auto end = (reinterpret_cast<uintptr_t>(_data + offset + size) + pageSize - 1) & ~(pageSize - 1);
+            return { reinterpret_cast<std::byte*>(beg), end - beg };
+        }
+#endif
+
+        void _release() noexcept
+        {
+            if (_data)
+            {
+#ifdef _WIN32
+                VirtualFree(_data, 0, MEM_RELEASE);
+#else
+                munmap(_data, _size);
+#endif
+                _data = nullptr;
+            }
+        }
+
+        std::byte* _data = nullptr;
+        size_t _size = 0;
+    };
+}
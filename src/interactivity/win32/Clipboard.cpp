@@ -204,6 +204,12 @@ void Clipboard::_copyToClipboard(const UINT format, const void* src, const size_
     memcpy(locked, src, bytes);
     GlobalUnlock(handle.get());
 
+    _setClipboardData(format, std::move(handle));
+}
+
+// Hands ownership of the given memory to the clipboard, if successful.
+void Clipboard::_setClipboardData(const UINT format, wil::unique_hglobal handle)
+{
     THROW_LAST_ERROR_IF_NULL(SetClipboardData(format, handle.get()));
     handle.release();
 }
@@ -310,7 +316,6 @@ InputEventQueue Clipboard::TextToKeyEvents(_In_reads_(cchData) const wchar_t* co
 //   <none>
 void Clipboard::StoreSelectionToClipboard(const bool copyFormatting)
 {
-    std::wstring text;
     std::string htmlData, rtfData;
 
     const auto& selection = Selection::Instance();
@@ -341,7 +346,19 @@ void Clipboard::StoreSelectionToClipboard(const bool copyFormatting)
     const auto& [selectionStart, selectionEnd] = selection.GetSelectionAnchors();
 
     const auto req = TextBuffer::CopyRequest::FromConfig(buffer, selectionStart, selectionEnd, singleLine, !selection.IsLineSelection(), false);
-    text = buffer.GetPlainText(req);
+
+    // The plain text is written straight into the clipboard's memory instead of building a std::wstring first.
+    // An empty span only measures the text. As per: https://learn.microsoft.com/en-us/windows/win32/dataxchg/standard-clipboard-formats
+    //   CF_UNICODETEXT: [...] A null character signals the end of the data.
+    // --> We add +1 to the length for the null terminator.
+    const auto textLength = buffer.GetPlainText(req, {});
+    wil::unique_hglobal textHandle{ THROW_LAST_ERROR_IF_NULL(GlobalAlloc(GMEM_MOVEABLE, (textLength + 1) * sizeof(wchar_t))) };
+    {
+        const auto locked = static_cast<wchar_t*>(GlobalLock(textHandle.get()));
+        buffer.GetPlainText(req, { locked, textLength });
+        locked[textLength] = L'\0';
+        GlobalUnlock(textHandle.get());
+    }
 
     if (copyFormatting)
     {
@@ -363,10 +380,7 @@ void Clipboard::StoreSelectionToClipboard(const bool copyFormatting)
     }
 
     EmptyClipboard();
-    // As per: https://learn.microsoft.com/en-us/windows/win32/dataxchg/standard-clipboard-formats
-    //   CF_UNICODETEXT: [...] A null character signals the end of the data.
-    // --> We add +1 to the length. This works because .c_str() is null-terminated.
-    _copyToClipboard(CF_UNICODETEXT, text.c_str(), (text.size() + 1) * sizeof(wchar_t));
+    _setClipboardData(CF_UNICODETEXT, std::move(textHandle));
 
     if (copyFormatting)
     {
@@ -36,6 +36,7 @@ namespace Microsoft::Console::Interactivity::Win32
     private:
         static wil::unique_close_clipboard_call _openClipboard(HWND hwnd);
         static void _copyToClipboard(UINT format, const void* src, size_t bytes);
+        static void _setClipboardData(UINT format, wil::unique_hglobal handle);
         static void _copyToClipboardRegisteredFormat(const wchar_t* format, const void* src, size_t bytes);
 
         void StringPaste(_In_reads_(cchData) PCWCHAR pwchData, const size_t cchData);
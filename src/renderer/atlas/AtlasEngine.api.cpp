@@ -48,8 +48,7 @@ constexpr HRESULT vec2_narrow(U x, U y, vec2<T>& out) noexcept
     //assert(psrRegion->top < psrRegion->bottom && psrRegion->top >= 0 && psrRegion->bottom <= _api.cellCount.y);
 
     // BeginPaint() protects against invalid out of bounds numbers.
-    _api.invalidatedRows.start = std::min(_api.invalidatedRows.start, gsl::narrow_cast<u16>(psrRegion->top));
-    _api.invalidatedRows.end = std::max(_api.invalidatedRows.end, gsl::narrow_cast<u16>(psrRegion->bottom));
+    _invalidateRows(gsl::narrow_cast<u16>(psrRegion->top), gsl::narrow_cast<u16>(psrRegion->bottom));
     return S_OK;
 }
 
@@ -96,19 +95,66 @@ void AtlasEngine::_invalidateSpans(std::span<const til::point_span> spans, const
             til::rect rect{ beg, row, end + 1, row + 1 };
             rect = rect.to_origin(viewportOrigin);
             rect &= viewport;
-            _api.invalidatedRows.start = gsl::narrow_cast<u16>(std::min<int>(_api.invalidatedRows.start, std::max<int>(0, rect.top)));
-            _api.invalidatedRows.end = gsl::narrow_cast<u16>(std::max<int>(_api.invalidatedRows.end, std::max<int>(0, rect.bottom)));
+            _invalidateRows(gsl::narrow_cast<u16>(std::max<int>(0, rect.top)), gsl::narrow_cast<u16>(std::max<int>(0, rect.bottom)));
         });
     }
 }
 
+// Adds [start, end) to the set of invalidated rows, merging it with any overlapping or adjacent ranges.
+// If that results in too many ranges, the two ranges with the smallest gap in between are merged.
+#pragma warning(suppress : 26447) // The function is declared 'noexcept' but calls function '...' which may throw exceptions (f.6).
+void AtlasEngine::_invalidateRows(u16 start, u16 end) noexcept
+{
+    if (start >= end)
+    {
+        return;
+    }
+
+    _api.invalidatedRows.start = std::min(_api.invalidatedRows.start, start);
+    _api.invalidatedRows.end = std::max(_api.invalidatedRows.end, end);
+
+    auto& ranges = _api.invalidatedRowRanges;
+    // The first range that isn't entirely to the left of [start, end).
+    const auto first = std::lower_bound(ranges.begin(), ranges.end(), start, [](const range<u16>& r, u16 v) { return r.end < v; });
+    auto last = first;
+
+    while (last != ranges.end() && last->start <= end)
+    {
+        start = std::min(start, last->start);
+        end = std::max(end, last->end);
+        ++last;
+    }
+
+    if (first != last)
+    {
+        *first = { start, end };
+        ranges.erase(first + 1, last);
+        return;
+    }
+
+    // The inline capacity is invalidatedRowRangesMax + 1, so this can't allocate.
+    ranges.insert(first, range<u16>{ start, end });
+
+    if (ranges.size() > invalidatedRowRangesMax)
+    {
+        size_t best = 0;
+        for (size_t i = 1; i < ranges.size() - 1; ++i)
+        {
+            if (ranges[i + 1].start - ranges[i].end < ranges[best + 1].start - ranges[best].end)
+            {
+                best = i;
+            }
+        }
+        ranges[best].end = ranges[best + 1].end;
+        ranges.erase(ranges.begin() + best + 1);
+    }
+}
+
 [[nodiscard]] HRESULT AtlasEngine::InvalidateSelection(std::span<const til::rect> selections) noexcept
 {
-    if (!selections.empty())
+    for (const auto& rect : selections)
     {
-        // INVARIANT: This assumes that `selections` is sorted by increasing Y
-        _api.invalidatedRows.start = gsl::narrow_cast<u16>(std::min<int>(_api.invalidatedRows.start, std::max<int>(0, selections.front().top)));
-        _api.invalidatedRows.end = gsl::narrow_cast<u16>(std::max<int>(_api.invalidatedRows.end, std::max<int>(0, selections.back().bottom)));
+        _invalidateRows(gsl::narrow_cast<u16>(std::max<int>(0, rect.top)), gsl::narrow_cast<u16>(std::max<int>(0, rect.bottom)));
     }
     return S_OK;
 }
@@ -130,7 +176,7 @@ void AtlasEngine::_invalidateSpans(std::span<const til::point_span> spans, const
         _api.invalidatedCursorArea.left = gsl::narrow_cast<u16>(clamp<int>(_api.invalidatedCursorArea.left + delta, u16min, u16max));
         _api.invalidatedCursorArea.right = gsl::narrow_cast<u16>(clamp<int>(_api.invalidatedCursorArea.right + delta, u16min, u16max));
 
-        _api.invalidatedRows = invalidatedRowsAll;
+        _invalidateRows(u16min, u16max);
     }
 
     if (const auto delta = pcoordDelta->y)
@@ -140,15 +186,24 @@ void AtlasEngine::_invalidateSpans(std::span<const til::point_span> spans, const
         _api.invalidatedCursorArea.top = gsl::narrow_cast<u16>(clamp<int>(_api.invalidatedCursorArea.top + delta, u16min, u16max));
         _api.invalidatedCursorArea.bottom = gsl::narrow_cast<u16>(clamp<int>(_api.invalidatedCursorArea.bottom + delta, u16min, u16max));
 
+        // Shift the pending row invalidations along with the contents...
+        const auto pending = _api.invalidatedRowRanges;
+        _api.invalidatedRowRanges.clear();
+        _api.invalidatedRows = invalidatedRowsNone;
+
+        for (const auto& r : pending)
+        {
+            _invalidateRows(gsl::narrow_cast<u16>(clamp<int>(r.start + delta, u16min, u16max)), gsl::narrow_cast<u16>(clamp<int>(r.end + delta, u16min, u16max)));
+        }
+
+        // ...and invalidate the rows that were scrolled in.
         if (delta < 0)
         {
-            _api.invalidatedRows.start = gsl::narrow_cast<u16>(clamp<int>(_api.invalidatedRows.start + delta, u16min, u16max));
-            _api.invalidatedRows.end = _api.s->viewportCellCount.y;
+            _invalidateRows(gsl::narrow_cast<u16>(clamp<int>(_api.s->viewportCellCount.y + delta, u16min, u16max)), _api.s->viewportCellCount.y);
         }
         else
         {
-            _api.invalidatedRows.start = 0;
-            _api.invalidatedRows.end = gsl::narrow_cast<u16>(clamp<int>(_api.invalidatedRows.end + delta, u16min, u16max));
+            _invalidateRows(0, gsl::narrow_cast<u16>(clamp<int>(delta, u16min, u16max)));
         }
     }
 
@@ -157,7 +212,7 @@ void AtlasEngine::_invalidateSpans(std::span<const til::point_span> spans, const
 
 [[nodiscard]] HRESULT AtlasEngine::InvalidateAll() noexcept
 {
-    _api.invalidatedRows = invalidatedRowsAll;
+    _invalidateRows(u16min, u16max);
     return S_OK;
 }
 
@@ -285,7 +340,7 @@ CATCH_RETURN()
 
 [[nodiscard]] HRESULT AtlasEngine::GetDirtyArea(std::span<const til::rect>& area) noexcept
 {
-    area = std::span{ &_api.dirtyRect, 1 };
+    area = std::span{ _api.dirtyRects.data(), _api.dirtyRects.size() };
     return S_OK;
 }
 
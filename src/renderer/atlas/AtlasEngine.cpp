@@ -9,6 +9,7 @@
 #include "Backend.h"
 #include "BuiltinGlyphs.h"
 #include "DWriteTextAnalysis.h"
+#include "../../buffer/out/textBuffer.hpp"
 #include "../../interactivity/win32/CustomWindowMessages.h"
 
 #include "../types/inc/ColorFix.hpp"
@@ -78,7 +79,7 @@ try
 
     if constexpr (ATLAS_DEBUG_DISABLE_PARTIAL_INVALIDATION)
     {
-        _api.invalidatedRows = invalidatedRowsAll;
+        _invalidateRows(u16min, u16max);
         _api.scrollOffset = 0;
     }
 
@@ -90,14 +91,27 @@ try
         _api.invalidatedCursorArea.bottom = clamp(_api.invalidatedCursorArea.bottom, _api.invalidatedCursorArea.top, _p.s->viewportCellCount.y);
     }
     {
-        _api.invalidatedRows.start = std::min(_api.invalidatedRows.start, _p.s->viewportCellCount.y);
-        _api.invalidatedRows.end = clamp(_api.invalidatedRows.end, _api.invalidatedRows.start, _p.s->viewportCellCount.y);
+        const auto height = _p.s->viewportCellCount.y;
+        auto& ranges = _api.invalidatedRowRanges;
+        size_t count = 0;
+
+        for (auto r : ranges)
+        {
+            r.start = std::min(r.start, height);
+            r.end = std::min(r.end, height);
+            if (r.non_empty())
+            {
+                ranges[count++] = r;
+            }
+        }
+
+        ranges.resize(count);
+        _api.invalidatedRows = count ? range<u16>{ ranges.front().start, ranges.back().end } : invalidatedRowsNone;
     }
     if (_api.scrollOffset)
     {
         const auto limit = gsl::narrow_cast<i16>(_p.s->viewportCellCount.y & 0x7fff);
         const auto offset = gsl::narrow_cast<i16>(clamp<int>(_api.scrollOffset, -limit, limit));
-        const auto nothingInvalid = _api.invalidatedRows.start == _api.invalidatedRows.end;
 
         _api.scrollOffset = offset;
 
@@ -105,23 +119,20 @@ try
         if (offset < 0)
         {
             const u16 begRow = _p.s->viewportCellCount.y + offset;
-            _api.invalidatedRows.start = nothingInvalid ? begRow : std::min(_api.invalidatedRows.start, begRow);
-            _api.invalidatedRows.end = _p.s->viewportCellCount.y;
+            _invalidateRows(begRow, _p.s->viewportCellCount.y);
         }
         else
         {
             const u16 endRow = offset;
-            _api.invalidatedRows.start = 0;
-            _api.invalidatedRows.end = nothingInvalid ? endRow : std::max(_api.invalidatedRows.end, endRow);
+            _invalidateRows(0, endRow);
         }
     }
 
-    _api.dirtyRect = {
-        0,
-        _api.invalidatedRows.start,
-        _p.s->viewportCellCount.x,
-        _api.invalidatedRows.end,
-    };
+    _api.dirtyRects.clear();
+    for (const auto& r : _api.invalidatedRowRanges)
+    {
+        _api.dirtyRects.push_back({ 0, r.start, _p.s->viewportCellCount.x, r.end });
+    }
 
     _p.dirtyRectInPx = {
         til::CoordTypeMax,
@@ -142,7 +153,7 @@ try
     //   the contents of the entire swap chain is redundant, but more importantly because the scroll rect
     //   is the subset of the contents that are being scrolled into. If you scroll the entire viewport
     //   then the scroll rect is empty, which Present1() will loudly complain about.
-    if (_p.invalidatedRows == range<u16>{ 0, _p.s->viewportCellCount.y })
+    if (_api.invalidatedRowRanges.size() == 1 && _p.invalidatedRows == range<u16>{ 0, _p.s->viewportCellCount.y })
     {
         _p.MarkAllAsDirty();
     }
@@ -234,19 +245,23 @@ try
         _p.dirtyRectInPx.right = targetSizeX;
         _p.dirtyRectInPx.bottom = std::max(_p.dirtyRectInPx.bottom, _p.invalidatedRows.end * _p.s->font->cellSize.y);
 
-        for (auto y = _p.invalidatedRows.start; y < _p.invalidatedRows.end; ++y)
+        // Only the rows in invalidatedRowRanges will be repainted. The ones in between keep their contents.
+        for (const auto& rows : _api.invalidatedRowRanges)
         {
-            const auto r = _p.rows[y];
-            const auto clampedTop = clamp(r->dirtyTop, 0, targetSizeY);
-            const auto clampedBottom = clamp(r->dirtyBottom, 0, targetSizeY);
-
-            if (clampedTop != clampedBottom)
+            for (auto y = rows.start; y < rows.end; ++y)
             {
-                _p.dirtyRectInPx.top = std::min(_p.dirtyRectInPx.top, clampedTop);
-                _p.dirtyRectInPx.bottom = std::max(_p.dirtyRectInPx.bottom, clampedBottom);
-            }
+                const auto r = _p.rows[y];
+                const auto clampedTop = clamp(r->dirtyTop, 0, targetSizeY);
+                const auto clampedBottom = clamp(r->dirtyBottom, 0, targetSizeY);
+
+                if (clampedTop != clampedBottom)
+                {
+                    _p.dirtyRectInPx.top = std::min(_p.dirtyRectInPx.top, clampedTop);
+                    _p.dirtyRectInPx.bottom = std::max(_p.dirtyRectInPx.bottom, clampedBottom);
+                }
 
-            r->Clear(y, _p.s->font->cellSize.y);
+                r->Clear(y, _p.s->font->cellSize.y);
+            }
         }
     }
 
@@ -279,6 +294,7 @@ try
 
     _api.invalidatedCursorArea = invalidatedAreaNone;
     _api.invalidatedRows = invalidatedRowsNone;
+    _api.invalidatedRowRanges.clear();
     _api.scrollOffset = 0;
     return S_OK;
 }
@@ -476,6 +492,48 @@ CATCH_RETURN()
 
 [[nodiscard]] HRESULT AtlasEngine::PaintBufferLine(std::span<const Cluster> clusters, til::point coord, const bool fTrimLeft, const bool lineWrapped) noexcept
 try
+{
+    return _paintBufferLine(coord, [&](u16 columnEnd) {
+        for (const auto& cluster : clusters)
+        {
+            for (const auto& ch : cluster.GetText())
+            {
+                _api.bufferLine.emplace_back(ch);
+                _api.bufferLineColumn.emplace_back(columnEnd);
+            }
+            columnEnd += gsl::narrow_cast<u16>(cluster.GetColumns());
+        }
+        return columnEnd;
+    });
+}
+CATCH_RETURN()
+
+// Same as PaintBufferLine(), but reads the text straight out of the row instead of
+// requiring the Renderer to turn each glyph into a Cluster first.
+[[nodiscard]] HRESULT AtlasEngine::PaintBufferRow(const RowView& row, const til::CoordType columnBegin, const til::CoordType columnEnd, til::point coord, const bool fTrimLeft, const bool lineWrapped) noexcept
+try
+{
+    return _paintBufferLine(coord, [&](u16 column) {
+        for (auto x = columnBegin; x < columnEnd;)
+        {
+            const auto glyph = row.GlyphAt(x);
+            for (const auto& ch : glyph.text)
+            {
+                _api.bufferLine.emplace_back(ch);
+                _api.bufferLineColumn.emplace_back(column);
+            }
+            column += gsl::narrow_cast<u16>(glyph.columnEnd - glyph.columnBegin);
+            x = glyph.columnEnd;
+        }
+        return column;
+    });
+}
+CATCH_RETURN()
+
+// appendText is called with the column the text starts at. It must append the text
+// to _api.bufferLine/bufferLineColumn and return the column past the end of the text.
+template<typename AppendText>
+[[nodiscard]] HRESULT AtlasEngine::_paintBufferLine(til::point coord, AppendText&& appendText)
 {
     const auto y = gsl::narrow_cast<u16>(clamp<int>(coord.y, 0, _p.s->viewportCellCount.y - 1));
 
@@ -486,7 +544,6 @@ try
 
     const auto shift = gsl::narrow_cast<u8>(_api.lineRendition != LineRendition::SingleWidth);
     const auto x = gsl::narrow_cast<u16>(clamp<int>(coord.x - (_api.viewportOffset.x >> shift), 0, _p.s->viewportCellCount.x));
-    auto columnEnd = x;
 
     // _api.bufferLineColumn contains 1 more item than _api.bufferLine, as it represents the
     // past-the-end index. It'll get appended again later once we built our new _api.bufferLine.
@@ -495,21 +552,9 @@ try
         _api.bufferLineColumn.pop_back();
     }
 
-    // Due to the current IRenderEngine interface (that wasn't refactored yet) we need to assemble
-    // the current buffer line first as the remaining function operates on whole lines of text.
-    {
-        for (const auto& cluster : clusters)
-        {
-            for (const auto& ch : cluster.GetText())
-            {
-                _api.bufferLine.emplace_back(ch);
-                _api.bufferLineColumn.emplace_back(columnEnd);
-            }
-            columnEnd += gsl::narrow_cast<u16>(cluster.GetColumns());
-        }
-
-        _api.bufferLineColumn.emplace_back(columnEnd);
-    }
+    // We need to assemble the current buffer line first as the remaining function operates on whole lines of text.
+    const u16 columnEnd = appendText(x);
+    _api.bufferLineColumn.emplace_back(columnEnd);
 
     // Apply the current foreground and background colors to the cells
     _fillColorBitmap(y, x, columnEnd, _api.currentForeground, _api.currentBackground);
@@ -522,7 +567,6 @@ try
     _api.lastPaintBufferLineCoord = { x, y };
     return S_OK;
 }
-CATCH_RETURN()
 
 [[nodiscard]] HRESULT AtlasEngine::PaintBufferGridLines(const GridLineSet lines, const COLORREF gridlineColor, const COLORREF underlineColor, const size_t cchLine, const til::point coordTarget) noexcept
 try
@@ -706,7 +750,7 @@ void AtlasEngine::_handleSettingsUpdate()
         _recreateCellCountDependentResources();
     }
 
-    _api.invalidatedRows = invalidatedRowsAll;
+    _invalidateRows(u16min, u16max);
 }
 
 void AtlasEngine::_recreateFontDependentResources()
@@ -42,6 +42,7 @@ namespace Microsoft::Console::Render::Atlas
         [[nodiscard]] HRESULT PrepareLineTransform(LineRendition lineRendition, til::CoordType targetRow, til::CoordType viewportLeft) noexcept override;
         [[nodiscard]] HRESULT PaintBackground() noexcept override;
         [[nodiscard]] HRESULT PaintBufferLine(std::span<const Cluster> clusters, til::point coord, bool fTrimLeft, bool lineWrapped) noexcept override;
+        [[nodiscard]] HRESULT PaintBufferRow(const RowView& row, til::CoordType columnBegin, til::CoordType columnEnd, til::point coord, bool fTrimLeft, bool lineWrapped) noexcept override;
         [[nodiscard]] HRESULT PaintBufferGridLines(const GridLineSet lines, const COLORREF gridlineColor, const COLORREF underlineColor, const size_t cchLine, const til::point coordTarget) noexcept override;
         [[nodiscard]] HRESULT PaintImageSlice(const ImageSlice& imageSlice, til::CoordType targetRow, til::CoordType viewportLeft) noexcept override;
         [[nodiscard]] HRESULT PaintSelection(const til::rect& rect) noexcept override;
@@ -84,6 +85,8 @@ namespace Microsoft::Console::Render::Atlas
         void _recreateFontDependentResources();
         void _recreateCellCountDependentResources();
         void _flushBufferLine();
+        template<typename AppendText>
+        [[nodiscard]] HRESULT _paintBufferLine(til::point coord, AppendText&& appendText);
         void _mapRegularText(size_t offBeg, size_t offEnd);
         void _mapBuiltinGlyphs(size_t offBeg, size_t offEnd);
         void _mapCharacters(const wchar_t* text, u32 textLength, u32* mappedLength, IDWriteFontFace2** mappedFontFace) const;
@@ -98,6 +101,7 @@ namespace Microsoft::Console::Render::Atlas
         void _resolveFontMetrics(const FontInfoDesired& fontInfoDesired, FontInfo& fontInfo, FontSettings* fontMetrics = nullptr);
         [[nodiscard]] bool _updateWithNearbyFontCollection() noexcept;
         void _invalidateSpans(std::span<const til::point_span> spans, const TextBuffer& buffer) noexcept;
+        void _invalidateRows(u16 start, u16 end) noexcept;
 
         // AtlasEngine.r.cpp
         ATLAS_ATTR_COLD void _recreateAdapter();
@@ -117,6 +121,8 @@ namespace Microsoft::Console::Render::Atlas
         static constexpr u16r invalidatedAreaNone = { u16max, u16max, u16min, u16min };
         static constexpr range<u16> invalidatedRowsNone{ u16max, u16min };
         static constexpr range<u16> invalidatedRowsAll{ u16min, u16max };
+        // The maximum number of disjoint row ranges we track before merging the closest ones.
+        static constexpr size_t invalidatedRowRangesMax = 8;
 
         static constexpr u32 highlightBg = 0xff00ffff;
         static constexpr u32 highlightFg = 0xff000000;
@@ -172,11 +178,15 @@ namespace Microsoft::Console::Render::Atlas
             std::span<const til::point_span> searchHighlightFocused;
             std::span<const til::point_span> selectionSpans;
 
-            // dirtyRect is a computed value based on invalidatedRows.
-            til::rect dirtyRect;
+            // dirtyRects is a computed value based on invalidatedRowRanges.
+            til::small_vector<til::rect, invalidatedRowRangesMax> dirtyRects;
             // These "invalidation" fields are reset in EndPaint()
             u16r invalidatedCursorArea = invalidatedAreaNone;
             range<u16> invalidatedRows = invalidatedRowsNone; // x is treated as "top" and y as "bottom"
+            // The sorted, disjoint row ranges that need to be redrawn. invalidatedRows is their bounding range.
+            // This allows us to skip the rows in between, for instance a clock in the status line and the cursor.
+            // It has room for one extra item, because _invalidateRows() inserts before it merges.
+            til::small_vector<range<u16>, invalidatedRowRangesMax + 1> invalidatedRowRanges;
             i16 scrollOffset = 0;
 
             // The position of the viewport inside the text buffer (in cells).
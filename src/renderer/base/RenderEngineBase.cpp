@@ -3,6 +3,8 @@
 
 #include "precomp.h"
 #include "../inc/RenderEngineBase.hpp"
+
+#include "../../buffer/out/textBuffer.hpp"
 #pragma hdrstop
 using namespace Microsoft::Console;
 using namespace Microsoft::Console::Render;
@@ -69,6 +71,28 @@ HRESULT RenderEngineBase::PrepareLineTransform(const LineRendition /*lineRenditi
     return S_FALSE;
 }
 
+// Method Description:
+// - Adapts PaintBufferRow() to PaintBufferLine() for engines that paint Clusters.
+//   Each glyph of the row is turned into a Cluster that spans all of the glyph's columns.
+HRESULT RenderEngineBase::PaintBufferRow(const RowView& row,
+                                         const til::CoordType columnBegin,
+                                         const til::CoordType columnEnd,
+                                         const til::point coord,
+                                         const bool fTrimLeft,
+                                         const bool lineWrapped) noexcept
+try
+{
+    _clusterBuffer.clear();
+    for (auto x = columnBegin; x < columnEnd;)
+    {
+        const auto glyph = row.GlyphAt(x);
+        _clusterBuffer.emplace_back(glyph.text, glyph.columnEnd - glyph.columnBegin);
+        x = glyph.columnEnd;
+    }
+    return PaintBufferLine({ _clusterBuffer.data(), _clusterBuffer.size() }, coord, fTrimLeft, lineWrapped);
+}
+CATCH_RETURN()
+
 HRESULT RenderEngineBase::PaintImageSlice(const ImageSlice& /*imageSlice*/,
                                           const til::CoordType /*targetRow*/,
                                           const til::CoordType /*viewportLeft*/) noexcept
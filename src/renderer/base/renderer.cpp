@@ -726,14 +726,13 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
             const auto& r = buffer.GetRowByOffset(row);
 
             // Draw the active composition.
-            // We have to use some tricks here with const_cast, because the code after it relies on TextBufferCellIterator,
-            // which isn't compatible with the scratchpad row. This forces us to back up and modify the actual row `r`.
-            ROW* rowBackup = nullptr;
+            // The composition is written into a copy of the row in the scratchpad, which we then draw instead of `r`.
+            const ROW* paintRow = &r;
             if (row == compositionRow)
             {
                 auto& scratch = buffer.GetScratchpadRow();
                 scratch.CopyFrom(r);
-                rowBackup = &scratch;
+                paintRow = &scratch;
 
                 std::wstring_view text{ activeComposition.text };
                 RowWriteState state{
@@ -759,17 +758,11 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
 
                     state.text = text.substr(off, len);
                     state.columnBegin = state.columnEnd;
-                    const_cast<ROW&>(r).ReplaceText(state);
-                    const_cast<ROW&>(r).ReplaceAttributes(state.columnBegin, state.columnEnd, attr);
+                    scratch.ReplaceText(state);
+                    scratch.ReplaceAttributes(state.columnBegin, state.columnEnd, attr);
                     off += len;
                 }
             }
-            const auto restore = wil::scope_exit([&] {
-                if (rowBackup)
-                {
-                    const_cast<ROW&>(r).CopyFrom(*rowBackup);
-                }
-            });
 
             // Convert the screen coordinates of the line to an equivalent
             // range of buffer cells, taking line rendition into account.
@@ -783,9 +776,6 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
             // of the backing buffer to fill in line 1 of the screen.
             const auto screenPosition = bufferLine.Origin() - til::point{ 0, view.Top() };
 
-            // Retrieve the cell information iterator limited to just this line we want to redraw.
-            auto it = buffer.GetCellDataAt(bufferLine.Origin(), bufferLine);
-
             // Calculate if two things are true:
             // 1. this row wrapped
             // 2. We're painting the last col of the row.
@@ -797,7 +787,7 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
             LOG_IF_FAILED(pEngine->PrepareLineTransform(lineRendition, screenPosition.y, view.Left()));
 
             // Ask the helper to paint through this specific line.
-            _PaintBufferOutputHelper(pEngine, it, screenPosition, lineWrapped);
+            _PaintBufferOutputHelper(pEngine, RowView{ *paintRow }, bufferLine.Left(), bufferLine.RightExclusive(), screenPosition, lineWrapped);
 
             // Paint any image content on top of the text.
             const auto imageSlice = buffer.GetRowByOffset(row).GetImageSlice();
@@ -816,33 +806,51 @@ static bool _IsAllSpaces(const std::wstring_view v)
 }
 
 void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
-                                        TextBufferCellIterator it,
+                                        const RowView& row,
+                                        const til::CoordType columnBegin,
+                                        til::CoordType columnEnd,
                                         const til::point target,
                                         const bool lineWrapped)
 {
     auto globalInvert{ _renderSettings.GetRenderMode(RenderSettings::Mode::ScreenReversed) };
 
+    columnEnd = std::min(columnEnd, row.size());
+
     // If we have valid data, let's figure out how to draw it.
-    if (it)
+    if (columnBegin >= 0 && columnBegin < columnEnd)
     {
-        // TODO: MSFT: 20961091 -  This is a perf issue. Instead of rebuilding this and allocing memory to hold the reinterpretation,
-        // we should have an iterator/view adapter for the rendering.
-        // That would probably also eliminate the RenderData needing to give us the entire TextBuffer as well...
-        // Retrieve the iterator for one line of information.
+        // We walk the row glyph by glyph via its RowView and in parallel keep track of the attribute run
+        // we're in, instead of materializing a cell with its own copy of the attributes for every column.
+        // Each run is then handed to the engine as a column range of the same RowView.
+        const auto& runs = row.Attributes().runs();
+        size_t runIndex = 0;
+        til::CoordType runEnd = runs.front().length;
+
+        // Returns the attributes at the given column. The column must not be less than the one in the previous call.
+        const auto attrAt = [&](til::CoordType column) noexcept -> const TextAttribute& {
+            while (column >= runEnd && runIndex + 1 < runs.size())
+            {
+                runIndex++;
+                runEnd += til::at(runs, runIndex).length;
+            }
+            return til::at(runs, runIndex).value;
+        };
+
         til::CoordType cols = 0;
+        auto x = columnBegin;
 
         // Retrieve the first color.
-        auto color = it->TextAttr();
+        auto color = attrAt(x);
         // Retrieve the first pattern id
         auto patternIds = _pData->GetPatternId(target);
         // Determine whether we're using a soft font.
-        auto usingSoftFont = s_IsSoftFontChar(it->Chars(), _firstSoftFontChar, _lastSoftFontChar);
+        auto usingSoftFont = s_IsSoftFontChar(row.GlyphAt(x).text, _firstSoftFontChar, _lastSoftFontChar);
 
         // And hold the point where we should start drawing.
         auto screenPoint = target;
 
         // This outer loop will continue until we reach the end of the text we are trying to draw.
-        while (it)
+        while (x < columnEnd)
         {
             // Hold onto the current run color right here for the length of the outer loop.
             // We'll be changing the persistent one as we run through the inner loops to detect
@@ -860,13 +868,15 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
             screenPoint.x += cols;
             cols = 0;
 
-            // Hold onto the start of this run iterator and the target location where we started
+            // Hold onto the start of this run and the target location where we started
             // in case we need to do some special work to paint the line drawing characters.
-            const auto currentRunItStart = it;
+            const auto currentRunColumnStart = x;
+            const auto currentRunRunIndex = runIndex;
+            const auto currentRunRunEnd = runEnd;
             const auto currentRunTargetStart = screenPoint;
 
-            // Ensure that our cluster vector is clear.
-            _clusterBuffer.clear();
+            // The first column of the first glyph in this run.
+            auto paintColumnBegin = x;
 
             // Reset our flag to know when we're in the special circumstance
             // of attempting to draw only the right-half of a two-column character
@@ -881,18 +891,19 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
             // We also accumulate clusters according to regex patterns
             do
             {
+                const auto glyph = row.GlyphAt(x);
+                const auto& attr = attrAt(x);
                 til::point thisPoint{ screenPoint.x + cols, screenPoint.y };
                 const auto thisPointPatterns = _pData->GetPatternId(thisPoint);
-                const auto thisUsingSoftFont = s_IsSoftFontChar(it->Chars(), _firstSoftFontChar, _lastSoftFontChar);
+                const auto thisUsingSoftFont = s_IsSoftFontChar(glyph.text, _firstSoftFontChar, _lastSoftFontChar);
                 const auto changedPatternOrFont = patternIds != thisPointPatterns || usingSoftFont != thisUsingSoftFont;
-                if (color != it->TextAttr() || changedPatternOrFont)
+                if (color != attr || changedPatternOrFont)
                 {
-                    auto newAttr{ it->TextAttr() };
                     // foreground doesn't matter for runs of spaces (!)
                     // if we trick it . . . we call Paint far fewer times for cmatrix
-                    if (!_IsAllSpaces(it->Chars()) || !newAttr.HasIdenticalVisualRepresentationForBlankSpace(color, globalInvert) || changedPatternOrFont)
+                    if (!_IsAllSpaces(glyph.text) || !attr.HasIdenticalVisualRepresentationForBlankSpace(color, globalInvert) || changedPatternOrFont)
                     {
-                        color = newAttr;
+                        color = attr;
                         patternIds = thisPointPatterns;
                         usingSoftFont = thisUsingSoftFont;
                         break; // vend this run
@@ -901,18 +912,20 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
 
                 // Walk through the text data and turn it into rendering clusters.
                 // Keep the columnCount as we go to improve performance over digging it out of the vector at the end.
-                auto columnCount = it->Columns();
+                auto columnCount = glyph.columnEnd - x;
 
                 // If we're on the first cluster to be added and it's marked as "trailing"
                 // (a.k.a. the right half of a two column character), then we need some special handling.
-                if (_clusterBuffer.empty() && it->DbcsAttr() == DbcsAttribute::Trailing)
+                if (x == currentRunColumnStart && glyph.columnBegin < x)
                 {
+                    // Paint the glyph starting at its leading half.
+                    paintColumnBegin = glyph.columnBegin;
                     // Move left to the one so the whole character can be struck correctly.
-                    --screenPoint.x;
+                    screenPoint.x -= x - glyph.columnBegin;
                     // And tell the next function to trim off the left half of it.
                     trimLeft = true;
-                    // And add one to the number of columns we expect it to take as we insert it.
-                    ++columnCount;
+                    // And add the hidden columns to the number of columns we expect it to take as we insert it.
+                    columnCount = glyph.columnEnd - glyph.columnBegin;
                 }
 
                 if (columnCount > 1)
@@ -920,15 +933,14 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
                     containsWideCharacter = true;
                 }
 
-                // Advance the cluster and column counts.
-                _clusterBuffer.emplace_back(it->Chars(), columnCount);
-                it += std::max(it->Columns(), 1); // prevent infinite loop for no visible columns
+                // Advance the column counts.
+                x = glyph.columnEnd;
                 cols += columnCount;
 
-            } while (it);
+            } while (x < columnEnd);
 
             // Do the painting.
-            THROW_IF_FAILED(pEngine->PaintBufferLine({ _clusterBuffer.data(), _clusterBuffer.size() }, screenPoint, trimLeft, lineWrapped));
+            THROW_IF_FAILED(pEngine->PaintBufferRow(row, paintColumnBegin, x, screenPoint, trimLeft, lineWrapped));
 
             // If we're allowed to do grid drawing, draw that now too (since it will be coupled with the color data)
             // We're only allowed to draw the grid lines under certain circumstances.
@@ -939,23 +951,25 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
                 // attribute that could have contained different line information than the left half.
                 if (containsWideCharacter)
                 {
-                    // Start from the original position in this run.
-                    auto lineIt = currentRunItStart;
-                    // Start from the original target in this run.
-                    auto lineTarget = currentRunTargetStart;
-
-                    // We need to go through the iterators again to ensure we get the lines associated with each
+                    // We need to go through the attributes again to ensure we get the lines associated with each
                     // exact column. The code above will condense two-column characters into one, but it is possible
                     // (like with the IME) that the line drawing characters will vary from the left to right half
-                    // of a wider character.
-                    // We could theoretically pre-pass for this in the loop above to be more efficient about walking
-                    // the iterator, but I fear it would make the code even more confusing than it already is.
-                    // Do that in the future if some WPR trace points you to this spot as super bad.
-                    for (til::CoordType colsPainted = 0; colsPainted < cols; ++colsPainted, ++lineIt, ++lineTarget.x)
+                    // of a wider character. We rewind our attribute run cursor to the start of the run for that.
+                    const auto resumeRunIndex = runIndex;
+                    const auto resumeRunEnd = runEnd;
+                    runIndex = currentRunRunIndex;
+                    runEnd = currentRunRunEnd;
+
+                    auto lineTarget = currentRunTargetStart;
+                    const auto lastColumn = row.size() - 1;
+                    for (til::CoordType colsPainted = 0; colsPainted < cols; ++colsPainted, ++lineTarget.x)
                     {
-                        auto lines = lineIt->TextAttr();
+                        const auto& lines = attrAt(std::min(currentRunColumnStart + colsPainted, lastColumn));
                         _PaintBufferOutputGridLineHelper(pEngine, lines, 1, lineTarget);
                     }
+
+                    runIndex = resumeRunIndex;
+                    runEnd = resumeRunEnd;
                 }
                 else
                 {
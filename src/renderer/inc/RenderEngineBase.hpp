@@ -43,6 +43,13 @@ namespace Microsoft::Console::Render
                                                    const til::CoordType targetRow,
                                                    const til::CoordType viewportLeft) noexcept override;
 
+        [[nodiscard]] HRESULT PaintBufferRow(const RowView& row,
+                                             const til::CoordType columnBegin,
+                                             const til::CoordType columnEnd,
+                                             const til::point coord,
+                                             const bool fTrimLeft,
+                                             const bool lineWrapped) noexcept override;
+
         [[nodiscard]] HRESULT PaintImageSlice(const ImageSlice& imageSlice,
                                               const til::CoordType targetRow,
                                               const til::CoordType viewportLeft) noexcept override;
@@ -57,5 +64,9 @@ namespace Microsoft::Console::Render
 
         bool _titleChanged = false;
         std::wstring _lastFrameTitle;
+
+    private:
+        // Reused by PaintBufferRow() across calls, so that it doesn't allocate.
+        std::vector<Cluster> _clusterBuffer;
     };
 }
@@ -50,11 +50,119 @@ UiaEngine::UiaEngine(IUiaEventDispatcher* dispatcher) :
     // If we had buffered any text from NotifyNewText, dump it. When we do come
     // back around to actually paint, we will just no-op. No sense in keeping
     // the data buffered.
-    _newOutput = std::wstring{};
+    _clearNewOutput();
 
     return S_OK;
 }
 
+// Routine Description:
+// - Sets the size of the ring buffer that NotifyNewText writes into and how often
+//   its contents are handed to automation clients. Any buffered text is discarded.
+// Arguments:
+// - limit - The maximum number of characters to buffer. Must not be 0.
+// - interval - The minimum time between two notifications.
+void UiaEngine::SetNewTextLimits(const size_t limit, const std::chrono::milliseconds interval) noexcept
+{
+    _clearNewOutput();
+    _newTextLimit = std::max<size_t>(limit, 1);
+    _newTextInterval = interval;
+}
+
+// Routine Description:
+// - Returns the number of characters passed to NotifyNewText that were dropped,
+//   because the ring buffer overflowed before they could be flushed.
+// - Once more characters than the limit given to SetNewTextLimits are buffered, the oldest ones are dropped.
+//   This keeps both the memory usage and the size of notifications constant,
+//   no matter how fast an application spews output.
+size_t UiaEngine::GetDroppedNewTextCount() const noexcept
+{
+    return _droppedNewOutput;
+}
+
+// Appends text to the _newOutput ring buffer, overwriting the oldest text if it's full.
+void UiaEngine::_appendNewOutput(std::wstring_view text) noexcept
+{
+    const auto limit = _newTextLimit;
+
+    if (_newOutput.size() != limit)
+    {
+        try
+        {
+            _newOutput.resize(limit);
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+            _clearNewOutput();
+            _droppedNewOutput += text.size();
+            return;
+        }
+    }
+
+    // Only the tail of the text can survive if it's larger than the buffer.
+    if (text.size() > limit)
+    {
+        _droppedNewOutput += text.size() - limit;
+        _newOutputTruncated = true;
+        text = text.substr(text.size() - limit);
+    }
+    if (text.empty())
+    {
+        return;
+    }
+
+    // Make room by dropping the oldest text.
+    if (const auto available = limit - _newOutputSize; text.size() > available)
+    {
+        const auto overflow = text.size() - available;
+        _droppedNewOutput += overflow;
+        _newOutputTruncated = true;
+        _newOutputHead = (_newOutputHead + overflow) % limit;
+        _newOutputSize -= overflow;
+    }
+
+    const auto tail = (_newOutputHead + _newOutputSize) % limit;
+    const auto first = std::min(text.size(), limit - tail);
+    std::copy_n(text.data(), first, _newOutput.data() + tail);
+    std::copy_n(text.data() + first, text.size() - first, _newOutput.data());
+    _newOutputSize += text.size();
+}
+
+// Moves the contents of the _newOutput ring buffer into _queuedOutput, so that Present() can
+// hand it to the automation clients outside of the console lock, and resets the ring buffer.
+void UiaEngine::_drainNewOutput()
+{
+    const std::wstring_view ring{ _newOutput };
+    const auto first = std::min(_newOutputSize, ring.size() - _newOutputHead);
+
+    _queuedOutput.clear();
+    _queuedOutput.reserve(_newOutputSize);
+    _queuedOutput.append(ring.substr(_newOutputHead, first));
+    _queuedOutput.append(ring.substr(0, _newOutputSize - first));
+
+    // If we overwrote older text, the beginning of the buffer is most likely the
+    // middle of a line. Don't read such a fragment out loud, if we have a whole line.
+    if (_newOutputTruncated)
+    {
+        if (const auto nl = _queuedOutput.find(L'\n'); nl != std::wstring::npos && nl + 1 < _queuedOutput.size())
+        {
+            _queuedOutput.erase(0, nl + 1);
+        }
+    }
+
+    _newOutputHead = 0;
+    _newOutputSize = 0;
+    _newOutputTruncated = false;
+}
+
+void UiaEngine::_clearNewOutput() noexcept
+{
+    _newOutput = std::wstring{};
+    _newOutputHead = 0;
+    _newOutputSize = 0;
+    _newOutputTruncated = false;
+}
+
 // Routine Description:
 // - Notifies us that the console has changed the character region specified.
 // - NOTE: This typically triggers on cursor or text buffer changes
@@ -153,8 +261,8 @@ try
 
     if (!newText.empty())
     {
-        _newOutput.append(newText);
-        _newOutput.push_back(L'\n');
+        _appendNewOutput(newText);
+        _appendNewOutput(L"\n");
         _textBufferChanged = true;
     }
     return S_OK;
@@ -172,7 +280,7 @@ CATCH_LOG_RETURN_HR(E_FAIL);
     RETURN_HR_IF(S_FALSE, !_isEnabled);
 
     // add more events here
-    const auto somethingToDo = _selectionChanged || _textBufferChanged || _cursorChanged || !_queuedOutput.empty();
+    const auto somethingToDo = _selectionChanged || _textBufferChanged || _cursorChanged || _newOutputSize != 0 || !_queuedOutput.empty();
 
     // If there's nothing to do, quick return
     RETURN_HR_IF(S_FALSE, !somethingToDo);
@@ -196,11 +304,34 @@ CATCH_LOG_RETURN_HR(E_FAIL);
     // so present can work on the copy while another
     // thread might start filling the next "frame"
     // worth of text data.
-    std::swap(_queuedOutput, _newOutput);
-    _newOutput.clear();
+    //
+    // Flushes are rate limited, so that an output flood results in a few
+    // large notifications instead of one per frame. Any text we hold back
+    // here is picked up by a later frame (see RequiresContinuousRedraw).
+    if (_newOutputSize != 0)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (_lastNewOutputFlush == std::chrono::steady_clock::time_point{} || now - _lastNewOutputFlush >= _newTextInterval)
+        {
+            try
+            {
+                _drainNewOutput();
+                _lastNewOutputFlush = now;
+            }
+            CATCH_LOG();
+        }
+    }
     return S_OK;
 }
 
+// Routine Description:
+// - Requests another frame as long as we're holding back new text due to the
+//   rate limit in EndPaint(), so that it doesn't get stuck once the output stops.
+[[nodiscard]] bool UiaEngine::RequiresContinuousRedraw() noexcept
+{
+    return _isEnabled && _newOutputSize != 0;
+}
+
 // RenderEngineBase defines a WaitUntilCanRender() that sleeps for 8ms to throttle rendering.
 // But UiaEngine is never the only engine running. Overriding this function prevents
 // us from sleeping 16ms per frame, when the other engine also sleeps for 8ms.
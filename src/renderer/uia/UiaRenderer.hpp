@@ -33,9 +33,18 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT Enable() noexcept;
         [[nodiscard]] HRESULT Disable() noexcept;
 
+        // Text passed to NotifyNewText is buffered in a ring of at most `limit` characters (only the
+        // most recent output is kept) and handed to automation clients at most once per `interval`.
+        static constexpr size_t DefaultNewTextLimit = 8 * 1024;
+        static constexpr std::chrono::milliseconds DefaultNewTextInterval{ 100 };
+
+        void SetNewTextLimits(size_t limit, std::chrono::milliseconds interval) noexcept;
+        size_t GetDroppedNewTextCount() const noexcept;
+
         // IRenderEngine Members
         [[nodiscard]] HRESULT StartPaint() noexcept override;
         [[nodiscard]] HRESULT EndPaint() noexcept override;
+        [[nodiscard]] bool RequiresContinuousRedraw() noexcept override;
         void WaitUntilCanRender() noexcept override;
         [[nodiscard]] HRESULT Present() noexcept override;
         [[nodiscard]] HRESULT ScrollFrame() noexcept override;
@@ -64,12 +73,28 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _DoUpdateTitle(const std::wstring_view newTitle) noexcept override;
 
     private:
+        void _appendNewOutput(std::wstring_view text) noexcept;
+        void _drainNewOutput();
+        void _clearNewOutput() noexcept;
+
         bool _isEnabled;
         bool _isPainting;
         bool _selectionChanged;
         bool _textBufferChanged;
         bool _cursorChanged;
+
+        size_t _newTextLimit = DefaultNewTextLimit;
+        std::chrono::milliseconds _newTextInterval = DefaultNewTextInterval;
+        // _newOutput is a ring buffer of _newTextLimit characters, allocated on first use.
+        // _newOutputHead is the index of the oldest character and _newOutputSize the number of valid ones.
         std::wstring _newOutput;
+        size_t _newOutputHead = 0;
+        size_t _newOutputSize = 0;
+        // Number of characters that were overwritten in the ring before they could be flushed.
+        size_t _droppedNewOutput = 0;
+        // Whether characters were dropped since the last time _newOutput was drained.
+        bool _newOutputTruncated = false;
+        std::chrono::steady_clock::time_point _lastNewOutputFlush{}; // default constructed = never flushed
         std::wstring _queuedOutput;
 
         Microsoft::Console::Types::IUiaEventDispatcher* _dispatcher;
@@ -416,6 +416,10 @@ void SixelParser::_scrollTextBuffer(Page& page, const int scrollAmount)
                 const auto eraseRowCount = expectedMovement - availableSpace;
                 const auto eraseOffset = std::max(_textMargins.top - _imageOriginCell.y, 0);
                 _eraseImageBufferRows(eraseRowCount, eraseOffset);
+                // Content above the margins doesn't move with the scroll, so we
+                // can't rely on the rows we previously flushed still matching
+                // up with the image buffer. We just repaint it all to be safe.
+                _imageDirtyTop = 0;
                 // But if there was any available space, we still then need to
                 // move the origin up as far as it can go.
                 expectedMovement = availableSpace;
@@ -535,6 +539,8 @@ void SixelParser::_defineColor(const size_t colorNumber, const COLORREF color)
         const auto tableIndex = til::at(_colorMap, colorNumber);
         til::at(_colorTable, tableIndex) = color;
         _colorTableChanged = true;
+        // Existing pixels referencing that entry will need to be repainted.
+        _imageDirtyTop = 0;
         // If some image content has already been defined at this point, and
         // we're processing the last character in the packet, this is likely an
         // attempt to animate the palette, so we should flush the image.
@@ -556,6 +562,7 @@ void SixelParser::_defineColor(const size_t colorNumber, const COLORREF color)
             til::at(_colorMap, colorNumber) = gsl::narrow_cast<IndexType>(tableIndex);
             til::at(_colorTable, tableIndex) = color;
             _colorTableChanged = true;
+            _imageDirtyTop = 0;
         }
         else if (_conformanceLevel == 2)
         {
@@ -626,6 +633,7 @@ void SixelParser::_initImageBuffer()
     _imageWidth = 0;
     _imageMaxWidth = _availablePixelWidth;
     _imageLineCount = 0;
+    _imageDirtyTop = 0;
     _resizeImageBuffer(_sixelHeight);
 
     _lastFlushLine = 0;
@@ -674,6 +682,7 @@ void SixelParser::_fillImageBackground()
         }
 
         _imageWidth = std::max(_imageWidth, backgroundWidth);
+        _imageDirtyTop = std::min(_imageDirtyTop, _imageCursor.y);
     }
 }
 
@@ -687,29 +696,46 @@ void SixelParser::_writeToImageBuffer(int sixelValue, int repeatCount)
     // Then we need to render the 6 vertical pixels that are represented by the
     // bits in the sixel value. Although note that each of these sixel pixels
     // may cover more than one device pixel, depending on the aspect ratio.
-    const auto targetOffset = _imageCursor.y * _imageMaxWidth + _imageCursor.x;
-    auto imageBufferPtr = std::next(_imageBuffer.data(), targetOffset);
+    // Rather than testing the bits one at a time, we skip over the unset bits
+    // and fill each run of set bits as a single block, since adjacent set bits
+    // (and the aspect ratio repeats of each bit) all produce identical rows.
     repeatCount = std::min(repeatCount, _imageMaxWidth - _imageCursor.x);
-    for (auto i = 0; i < 6; i++)
+    if (sixelValue != 0 && repeatCount > 0)
     {
-        if (sixelValue & 1)
+        const auto targetOffset = _imageCursor.y * _imageMaxWidth + _imageCursor.x;
+        auto imageBufferPtr = std::next(_imageBuffer.data(), targetOffset);
+        auto bits = gsl::narrow_cast<uint32_t>(sixelValue);
+        while (bits != 0)
         {
-            auto repeatAspectRatio = _pixelAspectRatio;
-            do
-            {
-                std::fill_n(imageBufferPtr, repeatCount, _foregroundPixel);
-                std::advance(imageBufferPtr, _imageMaxWidth);
-            } while (--repeatAspectRatio > 0);
-        }
-        else
-        {
-            std::advance(imageBufferPtr, _imageMaxWidth * _pixelAspectRatio);
+            const auto unsetCount = std::countr_zero(bits);
+            bits >>= unsetCount;
+            const auto setCount = std::countr_one(bits);
+            bits >>= setCount;
+
+            std::advance(imageBufferPtr, unsetCount * _pixelAspectRatio * _imageMaxWidth);
+            _fillImageRows(imageBufferPtr, repeatCount, setCount * _pixelAspectRatio);
+            std::advance(imageBufferPtr, setCount * _pixelAspectRatio * _imageMaxWidth);
         }
-        sixelValue >>= 1;
+        _imageDirtyTop = std::min(_imageDirtyTop, _imageCursor.y);
     }
     _imageCursor.x += repeatCount;
 }
 
+void SixelParser::_fillImageRows(IndexedPixel* dst, const til::CoordType width, const til::CoordType height) const noexcept
+{
+    // The first row is filled with the foreground pixel, and the remaining
+    // rows are copied from the first. Large repeat counts are common in images
+    // with solid areas (e.g. plots and rendered UI), so this ensures the bulk
+    // of the work is done with vectorized stores rather than a pixel loop.
+    const auto firstRow = dst;
+    std::fill_n(firstRow, width, _foregroundPixel);
+    for (auto i = 1; i < height; i++)
+    {
+        std::advance(dst, _imageMaxWidth);
+        std::memcpy(dst, firstRow, width * sizeof(IndexedPixel));
+    }
+}
+
 void SixelParser::_eraseImageBufferRows(const int rowCount, const til::CoordType rowOffset) noexcept
 {
     const auto pixelCount = rowCount * _cellSize.height;
@@ -719,11 +745,20 @@ void SixelParser::_eraseImageBufferRows(const int rowCount, const til::CoordType
     {
         _imageBuffer.clear();
         _imageCursor.y = 0;
+        _imageDirtyTop = 0;
     }
     else
     {
         _imageBuffer.erase(_imageBuffer.begin() + bufferOffset, _imageBuffer.begin() + bufferOffsetEnd);
         _imageCursor.y -= pixelCount;
+        // The dirty range shifts up along with the rows that followed the erased
+        // segment. If it started within the erased segment, it's clamped to the
+        // point where the following rows now begin.
+        const auto pixelOffset = rowOffset * _cellSize.height;
+        if (_imageDirtyTop > pixelOffset)
+        {
+            _imageDirtyTop = std::max(_imageDirtyTop - pixelCount, pixelOffset);
+        }
     }
 }
 
@@ -779,10 +814,24 @@ void SixelParser::_maybeFlushImageBuffer(const bool endOfSequence)
         // so the only visible change will be the scrolling.
         if (_imageWidth > 0)
         {
+            // The palette is converted to RGBQUAD values up front, so the pixel
+            // loop below is reduced to a table lookup for each opaque pixel.
+            std::array<RGBQUAD, MAX_COLORS> palette;
+            std::transform(_colorTable.begin(), _colorTable.end(), palette.begin(), _makeRGBQUAD);
+
+            // We only need to convert the rows that have been written to since
+            // the last flush, since everything above that is already up to date
+            // in the text buffer. For streamed images, that's typically just the
+            // most recent sixel band, rather than the entire image each time.
+            const auto bufferPixelHeight = gsl::narrow_cast<til::CoordType>(_imageBuffer.size() / _imageMaxWidth);
+            const auto dirtyRowCount = std::min(_imageDirtyTop, bufferPixelHeight) / _cellSize.height;
+            _imageDirtyTop = til::CoordTypeMax;
+
             const auto columnBegin = _imageOriginCell.x;
             const auto columnEnd = _imageOriginCell.x + (_imageWidth + _cellSize.width - 1) / _cellSize.width;
-            auto rowOffset = _imageOriginCell.y;
-            auto srcIterator = _imageBuffer.begin();
+            const auto topRowOffset = _imageOriginCell.y + dirtyRowCount;
+            auto rowOffset = topRowOffset;
+            auto srcIterator = std::next(_imageBuffer.begin(), dirtyRowCount * _cellSize.height * _imageMaxWidth);
             while (srcIterator < _imageBuffer.end() && rowOffset < page.Bottom())
             {
                 if (rowOffset >= 0)
@@ -797,13 +846,13 @@ void SixelParser::_maybeFlushImageBuffer(const bool endOfSequence)
                     auto dstIterator = dstSlice->MutablePixels(columnBegin, columnEnd);
                     for (auto pixelRow = 0; pixelRow < _cellSize.height; pixelRow++)
                     {
+                        const auto src = &*srcIterator;
                         for (auto pixelColumn = 0; pixelColumn < _imageWidth; pixelColumn++)
                         {
-                            const auto srcPixel = til::at(srcIterator, pixelColumn);
+                            const auto srcPixel = src[pixelColumn];
                             if (!srcPixel.transparent)
                             {
-                                const auto srcColor = _colorFromIndex(srcPixel.colorIndex);
-                                til::at(dstIterator, pixelColumn) = _makeRGBQUAD(srcColor);
+                                dstIterator[pixelColumn] = til::at(palette, srcPixel.colorIndex);
                             }
                         }
                         std::advance(srcIterator, _imageMaxWidth);
@@ -821,9 +870,16 @@ void SixelParser::_maybeFlushImageBuffer(const bool endOfSequence)
                 rowOffset++;
             }
 
+            // If some of the image extends past the bottom of the page, those
+            // rows will still need to be flushed if they're later scrolled into
+            // view, so we leave them marked as dirty.
+            if (srcIterator < _imageBuffer.end())
+            {
+                _imageDirtyTop = (rowOffset - _imageOriginCell.y) * _cellSize.height;
+            }
+
             // Trigger a redraw of the affected rows in the renderer.
-            const auto topRowOffset = std::max(_imageOriginCell.y, 0);
-            const auto dirtyView = Viewport::FromExclusive({ 0, topRowOffset, page.Width(), rowOffset });
+            const auto dirtyView = Viewport::FromExclusive({ 0, std::max(topRowOffset, 0), page.Width(), rowOffset });
             page.Buffer().TriggerRedraw(dirtyView);
 
             // If the start of the image is now above the top of the page, we
@@ -110,6 +110,7 @@ namespace Microsoft::Console::VirtualTerminal
         void _resizeImageBuffer(const til::CoordType requiredHeight);
         void _fillImageBackground();
         void _writeToImageBuffer(const int sixelValue, const int repeatCount);
+        void _fillImageRows(IndexedPixel* dst, const til::CoordType width, const til::CoordType height) const noexcept;
         void _eraseImageBufferRows(const int rowCount, const til::CoordType startRow = 0) noexcept;
         void _maybeFlushImageBuffer(const bool endOfSequence = false);
 
@@ -119,6 +120,7 @@ namespace Microsoft::Console::VirtualTerminal
         til::CoordType _imageWidth = 0;
         til::CoordType _imageMaxWidth = 0;
         size_t _imageLineCount = 0;
+        til::CoordType _imageDirtyTop = 0;
         size_t _lastFlushLine = 0;
         std::chrono::steady_clock::time_point _lastFlushTime;
     };
@@ -513,6 +513,9 @@ void AdaptDispatch::CursorSaveState()
     savedCursorState.IsOriginModeRelative = _modes.test(Mode::Origin);
     savedCursorState.Attributes = page.Attributes();
     savedCursorState.TermOutput = _termOutput;
+
+    // The buffer must not prune the saved hyperlink while DECRC may still restore it.
+    page.Buffer().SetSavedAttributes(savedCursorState.Attributes);
 }
 
 // Routine Description:
@@ -591,8 +594,10 @@ void AdaptDispatch::_ScrollRectVertically(const Page& page, const til::rect& scr
         if (width == page.Width())
         {
             // If the scrollRect is the full width of the buffer, we can scroll
-            // more efficiently by rotating the row storage.
-            textBuffer.ScrollRows(top, height, actualDelta);
+            // more efficiently by rotating the row storage. The rows that get
+            // rotated into the revealed area are reset, so that they don't keep
+            // the marks and wrap flags of the rows that were scrolled out.
+            textBuffer.RotateRows(top, height, actualDelta, _GetEraseAttributes(page));
             textBuffer.TriggerRedraw(Viewport::FromExclusive(scrollRect));
         }
         else
@@ -961,31 +966,26 @@ void AdaptDispatch::_ChangeRectAttributes(const Page& page, const til::rect& cha
 {
     if (changeRect)
     {
-        for (auto row = changeRect.top; row < changeRect.bottom; row++)
-        {
-            auto& rowBuffer = page.Buffer().GetMutableRowByOffset(row);
-            for (auto col = changeRect.left; col < changeRect.right; col++)
+        // The transformation is applied once per attribute run instead of once per cell.
+        page.Buffer().TransformAttributes(changeRect, [&](TextAttribute attr) {
+            auto characterAttributes = attr.GetCharacterAttributes();
+            characterAttributes &= changeOps.andAttrMask;
+            characterAttributes ^= changeOps.xorAttrMask;
+            attr.SetCharacterAttributes(characterAttributes);
+            if (changeOps.foreground)
             {
-                auto attr = rowBuffer.GetAttrByColumn(col);
-                auto characterAttributes = attr.GetCharacterAttributes();
-                characterAttributes &= changeOps.andAttrMask;
-                characterAttributes ^= changeOps.xorAttrMask;
-                attr.SetCharacterAttributes(characterAttributes);
-                if (changeOps.foreground)
-                {
-                    attr.SetForeground(*changeOps.foreground);
-                }
-                if (changeOps.background)
-                {
-                    attr.SetBackground(*changeOps.background);
-                }
-                if (changeOps.underlineColor)
-                {
-                    attr.SetUnderlineColor(*changeOps.underlineColor);
-                }
-                rowBuffer.ReplaceAttributes(col, col + 1, attr);
+                attr.SetForeground(*changeOps.foreground);
             }
-        }
+            if (changeOps.background)
+            {
+                attr.SetBackground(*changeOps.background);
+            }
+            if (changeOps.underlineColor)
+            {
+                attr.SetUnderlineColor(*changeOps.underlineColor);
+            }
+            return attr;
+        });
         page.Buffer().TriggerRedraw(Viewport::FromExclusive(changeRect));
         _api.NotifyAccessibilityChange(changeRect);
     }
@@ -2952,6 +2952,7 @@ void AdaptDispatch::SoftReset()
     // seems likely to be a bug. Most other terminals reset both.
     _savedCursorState.at(0) = {}; // Main buffer
     _savedCursorState.at(1) = {}; // Alt buffer
+    _pages.ActivePage().Buffer().SetSavedAttributes({});
 
     // The TerminalOutput state in these buffers must be reset to
     // the same state as the _termOutput instance, which is not
@@ -429,6 +429,67 @@ class RunLengthEncodingTests
         }
     }
 
+    TEST_METHOD(Transform)
+    {
+        struct TestCase
+        {
+            std::string_view source;
+
+            size_type start_index;
+            size_type end_index;
+            value_type old_value;
+            value_type new_value;
+
+            std::string_view expected;
+        };
+
+        std::array<TestCase, 8> test_cases{
+            {
+                // empty range
+                { "1|2|3", 1, 1, 2, 5, "1|2|3" },
+                // all, single run
+                { "1 1 1", 0, 3, 1, 2, "2 2 2" },
+                // all, joining runs
+                { "1|2|1", 0, 3, 1, 2, "2 2 2" },
+                // within a single run
+                { "1 1 1|2", 1, 2, 1, 3, "1|3|1|2" },
+                // join with predecessor run
+                { "2|1 1|3", 1, 3, 1, 2, "2 2 2|3" },
+                // join with predecessor and successor run
+                { "3|1 1|3", 0, 3, 1, 3, "3 3 3 3" },
+                // within runs
+                { "1 1|2 2|1 1", 1, 5, 1, 2, "1|2 2 2 2|1" },
+                // end_index larger than size()
+                { "1 1|2 2", 1, 9, 2, 1, "1 1 1 1" },
+            }
+        };
+
+        auto idx = 0;
+
+        for (const auto& test_case : test_cases)
+        {
+            rle_vector rle{ rle_encode(test_case.source) };
+            rle.transform(test_case.start_index, test_case.end_index, [&](const value_type& v) {
+                return v == test_case.old_value ? test_case.new_value : v;
+            });
+
+            VERIFY_ARE_EQUAL(
+                test_case.expected,
+                rle,
+                NoThrowString().Format(
+                    L"test case:   %d\nsource:      %hs\nstart_index: %u\nend_index:   %u\nold_value:   %u\nnew_value:   %u\nexpected:    %hs\nactual:      %s",
+                    idx,
+                    test_case.source.data(),
+                    test_case.start_index,
+                    test_case.end_index,
+                    test_case.old_value,
+                    test_case.new_value,
+                    test_case.expected.data(),
+                    rle.to_string().c_str()));
+            ++idx;
+        }
+    }
+
     TEST_METHOD(ResizeTrailingExtent)
     {
         constexpr std::string_view data{ "133211155" };
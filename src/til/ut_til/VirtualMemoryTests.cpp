@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include <til/virtual_memory.h>
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class VirtualMemoryTests
+{
+    TEST_CLASS(VirtualMemoryTests);
+
+    TEST_METHOD(CommitDecommit)
+    {
+        static constexpr size_t size = 1024 * 1024;
+
+        auto vm = til::virtual_memory::reserve(size);
+        VERIFY_IS_TRUE(static_cast<bool>(vm));
+        VERIFY_ARE_EQUAL(size, vm.size());
+
+        // Committing an unaligned range must make the entire range accessible.
+        vm.commit(100, 5000);
+        const std::span data{ vm.data() + 100, 5000 };
+        for (const auto b : data)
+        {
+            VERIFY_ARE_EQUAL(std::byte{}, b);
+        }
+        std::fill(data.begin(), data.end(), std::byte{ 0xab });
+
+        // Decommitted memory must come back zeroed when it's committed again.
+        vm.decommit(0, size);
+        vm.commit(0, size);
+        VERIFY_ARE_EQUAL(std::byte{}, vm.data()[100]);
+        VERIFY_ARE_EQUAL(std::byte{}, vm.data()[5099]);
+    }
+
+    TEST_METHOD(Move)
+    {
+        auto a = til::virtual_memory::reserve(64 * 1024);
+        const auto data = a.data();
+
+        auto b = std::move(a);
+        VERIFY_IS_FALSE(static_cast<bool>(a));
+        VERIFY_ARE_EQUAL(data, b.data());
+        VERIFY_ARE_EQUAL(64u * 1024u, b.size());
+    }
+};
@@ -11,6 +11,8 @@
 #define ENABLE_TEST_OUTPUT_SCROLL 1
 #define ENABLE_TEST_OUTPUT_FILL 1
 #define ENABLE_TEST_OUTPUT_READ 1
+#define ENABLE_TEST_OUTPUT_VT 1
+#define ENABLE_TEST_RENDER 1
 #define ENABLE_TEST_INPUT 1
 #define ENABLE_TEST_CLIPBOARD 1
 
@@ -22,6 +24,7 @@ struct BenchmarkContext
     bool wants_more() const;
     void mark_beg();
     void mark_end();
+    void mark_ticks(int64_t ticks);
     size_t rand();
 
     HWND hwnd = nullptr;
@@ -36,6 +39,8 @@ struct BenchmarkContext
     std::span<WORD> attr_4Ki;
     std::span<CHAR_INFO> char_4Ki;
     std::span<INPUT_RECORD> input_4Ki;
+    std::string_view sixel_image;
+    std::array<std::string_view, 2> colored_frames;
 
     Measurements m_measurements;
     size_t m_measurements_off = 0;
@@ -111,6 +116,25 @@ static constexpr Benchmark s_benchmarks[] = {
             }
         },
     },
+    Benchmark{
+        .title = "WriteConsoleW 4Ki East Asian ambiguous",
+        .exec = [](BenchmarkContext& ctx) {
+            // CJK text interspersed with East Asian Ambiguous characters (circled digits, box drawing, arrows, Greek, etc.).
+            // With the "console" text measurement mode, these are the characters whose width conhost asks the font about.
+            static constexpr std::wstring_view payload{ L"漢字①②③かな±×÷°§αβγ■□▲△○●※→←↑↓─│┌┐└┘カタカナ¶‐‘’“”…‰′″" };
+
+            const auto scratch = mem::get_scratch_arena(ctx.arena);
+            const auto buf = mem::repeat(scratch.arena, payload, 4 * 1024 / payload.size());
+
+            while (ctx.wants_more())
+            {
+                ctx.mark_beg();
+                const auto res = WriteConsoleW(ctx.output, buf.data(), static_cast<DWORD>(buf.size()), nullptr, nullptr);
+                ctx.mark_end();
+                debugAssert(res == TRUE);
+            }
+        },
+    },
     Benchmark{
         .title = "WriteConsoleOutputAttribute 4Ki",
         .exec = [](BenchmarkContext& ctx) {
@@ -342,6 +366,190 @@ static constexpr Benchmark s_benchmarks[] = {
         },
     },
 #endif
+#if ENABLE_TEST_OUTPUT_VT
+    Benchmark{
+        .title = "Sixel 800x480",
+        .exec = [](BenchmarkContext& ctx) {
+            while (ctx.wants_more())
+            {
+                ctx.mark_beg();
+                const auto res = WriteConsoleA(ctx.output, ctx.sixel_image.data(), static_cast<DWORD>(ctx.sixel_image.size()), nullptr, nullptr);
+                ctx.mark_end();
+                debugAssert(res == TRUE);
+            }
+        },
+    },
+    Benchmark{
+        .title = "DECCRA 80x12 with image",
+        .exec = [](BenchmarkContext& ctx) {
+            // Copies the top half of the sixel image over the bottom half.
+            static constexpr std::string_view deccra{ "\x1b[1;1;12;80;1;13;1;1$v" };
+
+            WriteConsoleA(ctx.output, ctx.sixel_image.data(), static_cast<DWORD>(ctx.sixel_image.size()), nullptr, nullptr);
+
+            while (ctx.wants_more())
+            {
+                ctx.mark_beg();
+                const auto res = WriteConsoleA(ctx.output, deccra.data(), static_cast<DWORD>(deccra.size()), nullptr, nullptr);
+                ctx.mark_end();
+                debugAssert(res == TRUE);
+            }
+        },
+    },
+    Benchmark{
+        .title = "DECCARA full screen",
+        .exec = [](BenchmarkContext& ctx) {
+            // Alternately sets and clears the bold attribute of the entire (uniformly colored) page.
+            static constexpr std::string_view sequences[]{ "\x1b[;;;;1$r", "\x1b[;;;;22$r" };
+
+            WriteConsoleA(ctx.output, "\x1b[2J", 4, nullptr, nullptr);
+
+            for (size_t i = 0; ctx.wants_more(); ++i)
+            {
+                const auto seq = sequences[i & 1];
+                ctx.mark_beg();
+                const auto res = WriteConsoleA(ctx.output, seq.data(), static_cast<DWORD>(seq.size()), nullptr, nullptr);
+                ctx.mark_end();
+                debugAssert(res == TRUE);
+            }
+        },
+    },
+    Benchmark{
+        .title = "DECRARA alternating-color rows",
+        .exec = [](BenchmarkContext& ctx) {
+            // Toggles the reverse attribute of an entire page whose color changes every 4 columns.
+            static constexpr std::string_view decrara{ "\x1b[;;;;7$t" };
+
+            const auto frame = ctx.colored_frames[0];
+            WriteConsoleA(ctx.output, frame.data(), static_cast<DWORD>(frame.size()), nullptr, nullptr);
+
+            while (ctx.wants_more())
+            {
+                ctx.mark_beg();
+                const auto res = WriteConsoleA(ctx.output, decrara.data(), static_cast<DWORD>(decrara.size()), nullptr, nullptr);
+                ctx.mark_end();
+                debugAssert(res == TRUE);
+            }
+        },
+    },
+    Benchmark{
+        .title = "Alternate screen toggle",
+        .exec = [](BenchmarkContext& ctx) {
+            // Enters the alternate screen, draws a line into it and leaves it again, like less or fzf do.
+            static constexpr std::string_view toggle{ "\x1b[?1049h\x1b[Hhello\x1b[?1049l" };
+
+            while (ctx.wants_more())
+            {
+                ctx.mark_beg();
+                const auto res = WriteConsoleA(ctx.output, toggle.data(), static_cast<DWORD>(toggle.size()), nullptr, nullptr);
+                ctx.mark_end();
+                debugAssert(res == TRUE);
+            }
+        },
+    },
+    Benchmark{
+        .title = "Scroll region line feeds",
+        .exec = [](BenchmarkContext& ctx) {
+            // Sets up a DECSTBM scroll region that excludes the first and last line (like a status line in tmux)
+            // and writes 1000 lines at its bottom, each of which scrolls the region by one row.
+            static constexpr std::string_view setup{ "\x1b[2;999r\x1b[999H" };
+            static constexpr std::string_view line{ "\r\nscrolling line" };
+            static constexpr std::string_view reset{ "\x1b[r" };
+            static constexpr size_t lines = 1000;
+
+            const auto scratch = mem::get_scratch_arena(ctx.arena);
+            const auto buf = scratch.arena.push_uninitialized<char>(line.size() * lines);
+            for (size_t i = 0; i < lines; ++i)
+            {
+                mem::copy(buf + i * line.size(), line.data(), line.size());
+            }
+
+            while (ctx.wants_more())
+            {
+                WriteConsoleA(ctx.output, setup.data(), static_cast<DWORD>(setup.size()), nullptr, nullptr);
+
+                ctx.mark_beg();
+                const auto res = WriteConsoleA(ctx.output, buf, static_cast<DWORD>(line.size() * lines), nullptr, nullptr);
+                ctx.mark_end();
+                debugAssert(res == TRUE);
+
+                WriteConsoleA(ctx.output, reset.data(), static_cast<DWORD>(reset.size()), nullptr, nullptr);
+            }
+        },
+    },
+#endif
+#if ENABLE_TEST_RENDER
+    Benchmark{
+        .title = "Full-screen redraw (conhost CPU cycles per frame)",
+        .exec = [](BenchmarkContext& ctx) {
+            // The rendering happens asynchronously on conhost's render thread, so instead of measuring
+            // how long the write takes, we measure how many CPU cycles conhost spent until the frame was painted.
+            // GetProcessTimes() only has a resolution of a timer tick (~15.6ms), which is why we use cycles.
+            DWORD pid = 0;
+            GetWindowThreadProcessId(ctx.hwnd, &pid);
+            const wil::unique_handle process{ OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid) };
+            if (!process)
+            {
+                return;
+            }
+
+            const auto cycles = [&]() {
+                ULONG64 c = 0;
+                QueryProcessCycleTime(process.get(), &c);
+                return static_cast<int64_t>(c);
+            };
+            // Waits until conhost stopped doing any work (= the render thread painted the last frame)
+            // and returns the cycle count at that point. The render thread runs at up to 60 FPS.
+            const auto wait_for_idle = [&]() {
+                auto prev = cycles();
+                for (;;)
+                {
+                    Sleep(20);
+                    const auto next = cycles();
+                    if (next == prev)
+                    {
+                        return next;
+                    }
+                    prev = next;
+                }
+            };
+
+            // The results are reported in QPC ticks, so we need to know how many cycles fit into one.
+            // We figure that out by spinning the current thread for a bit.
+            double ticks_per_cycle;
+            {
+                ULONG64 cyc_beg, cyc_end;
+                QueryThreadCycleTime(GetCurrentThread(), &cyc_beg);
+                const auto beg = query_perf_counter();
+                const auto end = beg + query_perf_freq() / 10;
+                auto now = beg;
+                while (now < end)
+                {
+                    now = query_perf_counter();
+                }
+                QueryThreadCycleTime(GetCurrentThread(), &cyc_end);
+                ticks_per_cycle = static_cast<double>(now - beg) / static_cast<double>(cyc_end - cyc_beg);
+            }
+
+            // Neither the cursor nor its blinking should add work to the measured frames.
+            static constexpr std::string_view hide_cursor{ "\x1b[?12l\x1b[?25l" };
+            WriteConsoleA(ctx.output, hide_cursor.data(), static_cast<DWORD>(hide_cursor.size()), nullptr, nullptr);
+
+            for (size_t i = 0; ctx.wants_more(); ++i)
+            {
+                const auto frame = ctx.colored_frames[i & 1];
+                const auto beg = wait_for_idle();
+                const auto res = WriteConsoleA(ctx.output, frame.data(), static_cast<DWORD>(frame.size()), nullptr, nullptr);
+                const auto end = wait_for_idle();
+                ctx.mark_ticks(static_cast<int64_t>(static_cast<double>(end - beg) * ticks_per_cycle));
+                debugAssert(res == TRUE);
+            }
+
+            static constexpr std::string_view show_cursor{ "\x1b[?12h\x1b[?25h" };
+            WriteConsoleA(ctx.output, show_cursor.data(), static_cast<DWORD>(show_cursor.size()), nullptr, nullptr);
+        },
+    },
+#endif
 #if ENABLE_TEST_INPUT
     Benchmark{
         .title = "WriteConsoleInputW 4Ki",
@@ -468,6 +676,8 @@ static constexpr INPUT_RECORD s_payload_record{
     },
 };
 
+static std::string_view make_sixel_image(mem::Arena& arena);
+static std::string_view make_colored_frame(mem::Arena& arena, int phase);
 static bool print_warning();
 static AccumulatedResults* prepare_results(mem::Arena& arena, std::span<const wchar_t*> paths);
 static std::span<Measurements> run_benchmarks_for_path(mem::Arena& arena, const wchar_t* path);
@@ -535,6 +745,88 @@ catch (...)
     return 1;
 }
 
+// Generates an 800x480 sixel image with 16 colors. Each band consists of solid stripes,
+// which are encoded with repeat introducers, and a noisy trace that's encoded with
+// individual sixels, similar to what you'd get from plotting libraries.
+static std::string_view make_sixel_image(mem::Arena& arena)
+{
+    static constexpr int width = 800;
+    static constexpr int height = 480;
+    static constexpr int colors = 16;
+    static constexpr int stripe = width / colors;
+    static constexpr size_t capacity = 256 * 1024;
+
+    const auto buf = arena.push_uninitialized<char>(capacity);
+    size_t len = 0;
+    const auto append = [&](std::string_view str) {
+        debugAssert(len + str.size() <= capacity);
+        mem::copy(buf + len, str.data(), str.size());
+        len += str.size();
+    };
+
+    append(mem::format(arena, "\033P0;1;0q\"1;1;%d;%d", width, height));
+
+    for (int c = 0; c < colors; ++c)
+    {
+        append(mem::format(arena, "#%d;2;%d;%d;%d", c, c * 100 / colors, 100 - c * 100 / colors, (c * 37) % 100));
+    }
+
+    for (int band = 0; band < height / 6; ++band)
+    {
+        for (int c = 0; c < colors - 1; ++c)
+        {
+            const auto x = ((c + band) % (colors - 1)) * stripe;
+            append(x ? mem::format(arena, "#%d!%d?!%d~$", c, x, stripe) : mem::format(arena, "#%d!%d~$", c, stripe));
+        }
+
+        append(mem::format(arena, "#%d", colors - 1));
+        for (int x = 0; x < width; ++x)
+        {
+            const char ch = static_cast<char>('?' + ((x * 7 + band * 3) & 63));
+            append({ &ch, 1 });
+        }
+        append("-");
+    }
+
+    append("\033\\");
+    return { buf, len };
+}
+
+// Fills the entire viewport with text that changes its color every 4 columns.
+// The two phases differ in every cell, so that alternating between them repaints the whole screen.
+static std::string_view make_colored_frame(mem::Arena& arena, int phase)
+{
+    static constexpr size_t capacity = 64 * 1024;
+
+    const auto buf = arena.push_uninitialized<char>(capacity);
+    size_t len = 0;
+    const auto append = [&](std::string_view str) {
+        debugAssert(len + str.size() <= capacity);
+        mem::copy(buf + len, str.data(), str.size());
+        len += str.size();
+    };
+
+    append("\033[H");
+
+    for (int y = 0; y < s_viewport_size.Y; ++y)
+    {
+        for (int x = 0; x < s_viewport_size.X; x += 4)
+        {
+            const char ch = static_cast<char>('a' + (x + y + phase) % 26);
+            const char run[4]{ ch, ch, ch, ch };
+            append(mem::format(arena, "\033[38;5;%dm", (x / 4 + y + phase * 7) % 256));
+            append({ &run[0], 4 });
+        }
+        if (y + 1 < s_viewport_size.Y)
+        {
+            append("\r\n");
+        }
+    }
+
+    append("\033[m");
+    return { buf, len };
+}
+
 static bool print_warning()
 {
     mem::print_literal(
@@ -685,6 +977,8 @@ static std::span<Measurements> run_benchmarks_for_path(mem::Arena& arena, const
         .attr_4Ki = mem::repeat(scratch.arena, s_payload_attr, 4 * 1024),
         .char_4Ki = mem::repeat(scratch.arena, s_payload_char, 4 * 1024),
         .input_4Ki = mem::repeat(scratch.arena, s_payload_record, 4 * 1024),
+        .sixel_image = make_sixel_image(scratch.arena),
+        .colored_frames = { make_colored_frame(scratch.arena, 0), make_colored_frame(scratch.arena, 1) },
 
         .m_measurements = scratch.arena.push_uninitialized_span<int32_t>(4 * 1024 * 1024),
     };
@@ -881,6 +1175,14 @@ void BenchmarkContext::mark_end()
     m_time = end;
 }
 
+// Records a measurement (in QPC ticks) that wasn't taken with mark_beg/mark_end,
+// like the CPU time another process consumed.
+void BenchmarkContext::mark_ticks(int64_t ticks)
+{
+    m_measurements[m_measurements_off++] = static_cast<int32_t>(ticks);
+    m_time = query_perf_counter();
+}
+
 size_t BenchmarkContext::rand()
 {
     // These constants are the same as used by the PCG family of random number generators.
@@ -1146,7 +1146,7 @@ bool CodepointWidthDetector::_graphemeNextConsole(GraphemeState& s, const std::w
         width = ucdToCharacterWidth(val);
         if (width == 3)
         {
-            width = _checkFallbackViaCache(cp);
+            width = _checkFallback(cp);
         }
 
         delayedCompletion = clusterEnd >= end;
@@ -1192,7 +1192,7 @@ bool CodepointWidthDetector::_graphemePrevConsole(GraphemeState& s, const std::w
         width = ucdToCharacterWidth(val);
         if (width == 3)
         {
-            width = _checkFallbackViaCache(cp);
+            width = _checkFallback(cp);
         }
 
         delayedCompletion = clusterBeg <= beg;
@@ -1205,8 +1205,19 @@ bool CodepointWidthDetector::_graphemePrevConsole(GraphemeState& s, const std::w
     return delayedCompletion == 0;
 }
 
+// Turns ambiguous (width = 3) into narrow/wide. Previously resolved BMP codepoints
+// are answered straight from the bitsets without leaving the parser's hot loop.
+int CodepointWidthDetector::_checkFallback(const char32_t codepoint) noexcept
+{
+    if (codepoint <= 0xffff && _fallbackKnown.test(codepoint))
+    {
+        return _fallbackWide.test(codepoint) ? 2 : 1;
+    }
+    return _checkFallbackViaCache(codepoint);
+}
+
 // Call the function specified via SetFallbackMethod() to turn ambiguous (width = 3) into narrow/wide.
-// Caches the results in _fallbackCache.
+// Caches the results in _fallbackKnown/_fallbackWide and _fallbackCache.
 int CodepointWidthDetector::_checkFallbackViaCache(const char32_t codepoint) noexcept
 try
 {
@@ -1216,11 +1227,25 @@ try
         return 1;
     }
 
-    if (const auto it = _fallbackCache.find(codepoint); it != _fallbackCache.end())
+    if (codepoint > 0xffff)
     {
-        return it->second;
+        if (const auto it = _fallbackCache.find(codepoint); it != _fallbackCache.end())
+        {
+            return it->second;
+        }
     }
 
+    return _queryFallback(codepoint);
+}
+catch (...)
+{
+    LOG_CAUGHT_EXCEPTION();
+    return 1;
+}
+
+// Asks _pfnFallbackMethod for the width of the given codepoint and caches the result.
+int CodepointWidthDetector::_queryFallback(const char32_t codepoint)
+{
     wchar_t buf[2];
     size_t len;
     if (codepoint <= 0xffff)
@@ -1235,14 +1260,17 @@ try
         len = 2;
     }
 
-    const int width = _pfnFallbackMethod({ &buf[0], len }) ? 2 : 1;
-    _fallbackCache.insert_or_assign(codepoint, width);
-    return width;
-}
-catch (...)
-{
-    LOG_CAUGHT_EXCEPTION();
-    return 1;
+    const auto wide = _pfnFallbackMethod({ &buf[0], len });
+    if (codepoint <= 0xffff)
+    {
+        _fallbackKnown.set(codepoint);
+        _fallbackWide.set(codepoint, wide);
+    }
+    else
+    {
+        _fallbackCache.insert_or_assign(codepoint, wide ? 2 : 1);
+    }
+    return wide ? 2 : 1;
 }
 
 TextMeasurementMode CodepointWidthDetector::GetMode() const noexcept
@@ -1265,8 +1293,44 @@ void CodepointWidthDetector::SetFallbackMethod(std::function<bool(const std::wst
     _pfnFallbackMethod = std::move(pfnFallback);
 }
 
+// Method Description:
+// - Resolves the width of all ambiguous codepoints in the BMP via the fallback method upfront,
+//      so that text output doesn't need to stop and ask the renderer about each new one.
+//   The private use area is skipped, because it's large, rarely used in its entirety
+//      and gets resolved lazily just like the supplementary planes.
+//   This should be called after Reset() whenever the font changes.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CodepointWidthDetector::ResolveAmbiguousWidths() noexcept
+try
+{
+    if (!_pfnFallbackMethod)
+    {
+        return;
+    }
+
+    for (char32_t cp = 0; cp <= 0xffff; ++cp)
+    {
+        // Skip the surrogates and the private use area (U+D800 to U+F8FF).
+        if (cp == 0xD800)
+        {
+            cp = 0xF8FF;
+            continue;
+        }
+        if (!_fallbackKnown.test(cp) && ucdToCharacterWidth(ucdLookup(cp)) == 3)
+        {
+            _queryFallback(cp);
+        }
+    }
+}
+CATCH_LOG()
+
 void CodepointWidthDetector::Reset(const TextMeasurementMode mode) noexcept
 {
     _mode = mode;
+    _fallbackKnown.reset();
+    _fallbackWide.reset();
     _fallbackCache.clear();
 }
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <bitset>
+
 enum class TextMeasurementMode
 {
     // Uses a method very similar to the official UAX #29 Extended Grapheme Cluster algorithm.
@@ -57,6 +59,7 @@ struct CodepointWidthDetector
 
     TextMeasurementMode GetMode() const noexcept;
     void SetFallbackMethod(std::function<bool(const std::wstring_view&)> pfnFallback) noexcept;
+    void ResolveAmbiguousWidths() noexcept;
     void Reset(TextMeasurementMode mode) noexcept;
 
 private:
@@ -66,8 +69,14 @@ private:
     bool _graphemePrevWcswidth(GraphemeState& s, const std::wstring_view& str) const noexcept;
     bool _graphemeNextConsole(GraphemeState& s, const std::wstring_view& str) noexcept;
     bool _graphemePrevConsole(GraphemeState& s, const std::wstring_view& str) noexcept;
+    int _checkFallback(char32_t codepoint) noexcept;
     __declspec(noinline) int _checkFallbackViaCache(char32_t codepoint) noexcept;
+    int _queryFallback(char32_t codepoint);
 
+    // Results of _pfnFallbackMethod for the BMP. A codepoint is wide if its bit in both sets is set.
+    // Everything outside the BMP (mostly the supplementary private use areas) goes into _fallbackCache.
+    std::bitset<0x10000> _fallbackKnown;
+    std::bitset<0x10000> _fallbackWide;
     std::unordered_map<char32_t, int> _fallbackCache;
     std::function<bool(const std::wstring_view&)> _pfnFallbackMethod;
     TextMeasurementMode _mode = TextMeasurementMode::Graphemes;
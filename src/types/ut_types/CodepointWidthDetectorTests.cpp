@@ -1419,4 +1419,51 @@ class CodepointWidthDetectorTests
             VERIFY_ARE_EQUAL(test.widthsPrev, actualWidths);
         }
     }
+
+    TEST_METHOD(ResolvedAmbiguousWidths)
+    {
+        // U+2460 (circled digit one) and U+00B1 (plus-minus) are ambiguous. U+E000 is in the private use area.
+        static constexpr std::wstring_view text{ L"\u2460\u00B1\uE000" };
+
+        CodepointWidthDetector cwd;
+        std::vector<std::wstring> queried;
+        cwd.SetFallbackMethod([&](const std::wstring_view& glyph) {
+            queried.emplace_back(glyph);
+            return glyph == L"\u2460" || glyph == L"\uE000";
+        });
+        cwd.Reset(TextMeasurementMode::Console);
+
+        cwd.ResolveAmbiguousWidths();
+        const auto resolved = queried.size();
+        VERIFY_IS_TRUE(resolved > 0);
+        VERIFY_IS_TRUE(std::ranges::find(queried, L"\u2460") != queried.end());
+        VERIFY_IS_TRUE(std::ranges::find(queried, L"\uE000") == queried.end());
+
+        const auto measure = [&]() {
+            std::vector<int> widths;
+            for (GraphemeState state;;)
+            {
+                const auto ok = cwd.GraphemeNext(state, text);
+                widths.emplace_back(state.width);
+                if (!ok)
+                {
+                    break;
+                }
+            }
+            return widths;
+        };
+
+        // Only the private use character needs to be queried lazily and only once.
+        const std::vector<int> expected{ 2, 1, 2 };
+        VERIFY_ARE_EQUAL(expected, measure());
+        VERIFY_ARE_EQUAL(resolved + 1, queried.size());
+        VERIFY_ARE_EQUAL(expected, measure());
+        VERIFY_ARE_EQUAL(resolved + 1, queried.size());
+
+        // Reset() is what invalidates the results when the font changes.
+        cwd.Reset(TextMeasurementMode::Console);
+        queried.clear();
+        VERIFY_ARE_EQUAL(expected, measure());
+        VERIFY_ARE_EQUAL(3u, queried.size());
+    }
 };